@@ -16,7 +16,16 @@ and transformations (in later labs).
 *//*__________________________________________________________________________*/
 #include <glhelper.h>
 #include <glslshader.h>
-#include <list>
+#include <gljobs.h>
+#include <glvertexformat.h>
+#include <glrenderqueue.h>
+#include <glcamera.h>
+#include <glgrid.h>
+#include <glgpucull.h>
+#include <glgpusim.h>
+#include <cstdint>
+
+struct GLMesh;
 /*                                                                      guard
 ----------------------------------------------------------------------------- */
 #ifndef GLAPP_H
@@ -28,6 +37,7 @@ and transformations (in later labs).
 // As stated in tutorial
 #define WORLD_WIDTH 10000.0f
 #define WORLD_HEIGHT 10000.0f
+// default of GLApp::max_objects
 #define MAX_OBJECTS 32768
 
 struct GLApp {
@@ -42,7 +52,26 @@ struct GLApp {
 	static std::vector<GLSLShader> shdrpgms;		// singleton
 	using VPSS = std::vector<std::pair<std::string, std::string>>;
 	static void init_shdrpgms_cont(GLApp::VPSS const&); // initialize singleton
-
+	// index in shdrpgms of a permutation of a program given to
+	// init_shdrpgms_cont, submitted for compilation on first use; the
+	// program can't be used before finish_shdrpgms has been called
+	static GLuint shdrpgm_variant(size_t source, GLSLShader::Permutation key);
+	static void finish_shdrpgms();
+
+	// If set before init, the shader files given to init_shdrpgms_cont are
+	// watched (see GLShaderWatch) and reload_shdrpgms, called at the start
+	// of every frame, replaces a program whose sources changed once the new
+	// version has linked. A program that fails keeps the previous version.
+	static bool hot_reload;
+	static void reload_shdrpgms();
+
+	// object budget: the capacity of GLApp::objects and of every buffer
+	// sized per object. Set it before init, to a value in [1,
+	// MAX_OBJECT_BUDGET]; it can't change afterwards
+	static size_t max_objects;
+	// largest object budget: objects are indexed by GLuint, and the render
+	// queue orders them by age in GLRenderQueue::DEPTH_BITS bits
+	static constexpr size_t MAX_OBJECT_BUDGET = size_t(1) << GLRenderQueue::DEPTH_BITS;
 
 
 	// encapsulates state required to render a geometrical model
@@ -52,8 +81,12 @@ struct GLApp {
 		GLuint vaoid;
 		GLuint draw_cnt;
 		GLuint model_cnt;
+		GLenum index_type;		// GL_UNSIGNED_SHORT, or GL_UNSIGNED_INT for large meshes
+		GLVertexFormat format;	// layout of the vertex buffer, filled by the loader
+		GLuint shdrpgm;			// index in shdrpgms of the program drawing the model
+		GLfloat radius;			// radius of the bounding circle centred at the origin
 
-		GLModel() : primitive_type(0), primitive_cnt(0), vaoid(0), draw_cnt(0), model_cnt(0) {}
+		GLModel() : primitive_type(0), primitive_cnt(0), vaoid(0), draw_cnt(0), model_cnt(0), index_type(GL_UNSIGNED_SHORT), shdrpgm(0), radius(0.0f) {}
 
 	};
 
@@ -61,23 +94,154 @@ struct GLApp {
 	static std::vector<GLApp::GLModel> models; // singleton
 	static GLApp::GLModel box_model();
 	static GLApp::GLModel mystery_model();
+	static GLApp::GLModel mesh_model(GLMesh const& mesh);
 	static void init_models_cont(); // initialize singleton
 
+	// OBJ file loaded as an additional model if not empty (see GLMesh)
+	static std::string mesh_path;
+	// models' vertices are stored quantized unless this is cleared before
+	// init_models_cont (see GLVertexFormat)
+	static bool quantize_vertices;
+
+	// persistently mapped buffer that the CPU streams data to every frame ...
+	// The storage is split into region_cnt regions that are used round-robin,
+	// one per frame, and stays mapped for the lifetime of the buffer so the
+	// CPU writes straight into GPU-visible memory. Before a region is written
+	// again, the CPU waits on the fence placed after the GPU commands that
+	// last read it; waits that actually block are counted in stall_cnt.
+	struct GLStreamBuffer {
+		GLuint bufid;
+		GLsizeiptr region_size;			// size in bytes of one region
+		GLuint region_cnt;
+		GLuint region;					// region currently written by the CPU
+		GLubyte* mapped;				// persistently mapped storage
+		std::vector<GLsync> fences;		// fence of the last GPU use of each region
+		GLuint stall_cnt;				// number of fence waits that blocked
+
+		GLStreamBuffer() : bufid(0), region_size(0), region_cnt(0), region(0), mapped(nullptr), stall_cnt(0) {}
+
+		void init(GLsizeiptr size, GLuint count);
+		// wait until the GPU is done with the current region and return its
+		// mapped address
+		void* begin_region();
+		// fence the GPU commands that read the current region and advance to
+		// the next one
+		void end_region();
+		// offset in bytes of the current region
+		GLintptr region_offset() const;
+		void destroy();
+	};
 
-	struct GLObject {
-		glm::vec2 scaling;				// scaling
-		GLfloat angle_speed, angle_disp;	// orientation
-		glm::vec2 position;				// translation
-		glm::mat3 mdl_to_ndc_xform;
-		GLuint mdl_ref, shd_ref;
-
-		// set up initial state
-		void init();
-		void draw() const;
-		void update(GLdouble delta_time);
+	// per-instance transforms for instanced rendering ...
+	// every region of instance_stream holds one model-to-NDC transform per
+	// object. Objects are ordered by the sort key of their draw state in
+	// render_queue, so that every run of objects drawn with the same state
+	// occupies a consecutive range of instances and is rendered with a
+	// single instanced draw call; GLApp::update writes the transforms
+	// directly into the region
+	static constexpr GLuint INSTANCE_REGIONS = 3;	// triple buffered
+	static GLStreamBuffer instance_stream;
+	static GLRenderQueue render_queue;
+	static void init_instance_buffer();
+	static void bind_instance_attribs(GLuint vaoid);
+	static void queue_objects();
+	static void draw_instanced();
+	static void draw_gpu_culled();
+	static GLuint draw_cnt;							// draw calls of the last frame
+
+	// camera through which the world is viewed ...
+	// only objects whose bounding circles overlap its view are queued and
+	// drawn; grid indexes the objects' bounding circles by slot to find them
+	// without testing every object. The number of objects queued and culled
+	// by the last update are kept for the stats
+	static GLCamera camera;
+	static constexpr GLuint GRID_CELLS = 16;		// per side of the world
+	static GLGrid grid;
+	static GLuint visible_cnt, culled_cnt;
+
+
+	// stable handle to an object; it stays valid until the object is killed
+	using ObjectHandle = std::uint64_t;
+
+	// structure-of-arrays store for every object's state ...
+	// each attribute lives in its own tightly packed array and an object is
+	// the set of elements sharing one slot index across the arrays.
+	// Objects are kept in spawn order in a ring of fixed capacity: handles
+	// are consecutive spawn numbers, live handles are [head, tail) and the
+	// slot of a handle is handle % capacity. Killing the oldest objects is
+	// therefore just a matter of advancing head.
+	struct GLObjects {
+		std::vector<glm::vec2> scaling;				// scaling
+		std::vector<GLfloat> angle_speed, angle_disp;	// orientation
+		std::vector<glm::vec2> position;			// translation
+		std::vector<GLuint> instance_idx;			// instance of the transform in a region
+		std::vector<GLuint> mdl_ref, shd_ref;
+
+		ObjectHandle head = 0, tail = 0;			// live handles are [head, tail)
+
+		// allocate every array for the given number of objects
+		void reserve(size_t capacity);
+		size_t capacity() const;
+		size_t size() const;
+		bool empty() const;
+
+		// append a new object with random initial state and return its handle
+		ObjectHandle spawn();
+		// append count new objects, initialized in parallel by the job
+		// system, and return the handle of the first; the others follow it
+		ObjectHandle spawn(size_t count);
+		// kill the count oldest objects
+		void kill_oldest(size_t count);
+		bool alive(ObjectHandle hdl) const;
+		size_t slot(ObjectHandle hdl) const;
+
+		// set up random initial state of the objects in slots [begin, end),
+		// whose handles start at first (see GLRandom)
+		void init(size_t begin, size_t end, ObjectHandle first);
+		// radius of the bounding circle of the object in slot, whatever its
+		// orientation
+		GLfloat bound_radius(size_t slot) const;
+		// update the objects in slots [begin, end) and write their model-to-NDC
+		// transforms to instances[instance_idx[slot]]
+		void update(size_t begin, size_t end, GLdouble delta_time, glm::mat3* instances);
+		// update the objects in slots [begin, end) and write their states,
+		// for GPU culling, to states[age] (see GLGpuCull)
+		void update_states(size_t begin, size_t end, GLdouble delta_time, size_t oldest, GLGpuCull::Object* states);
+		// state of the object in slot as read by GPU culling and simulation
+		GLGpuCull::Object state(size_t slot) const;
+
+		// live objects occupy at most two contiguous ranges of slots because
+		// the ring may wrap around; call fn(begin, end) for each of them in
+		// spawn order
+		template <typename Fn>
+		void for_each_range(Fn fn) const {
+			for_each_slot_range(head, tail, fn);
+		}
+		// the same for the objects with handles [first, last)
+		template <typename Fn>
+		void for_each_slot_range(ObjectHandle first, ObjectHandle last, Fn fn) const {
+			if (first == last) {
+				return;
+			}
+			size_t const begin = slot(first);
+			size_t const end = begin + static_cast<size_t>(last - first);
+			if (end <= capacity()) {
+				fn(begin, end);
+			}
+			else {
+				fn(begin, capacity());
+				fn(size_t(0), end - capacity());
+			}
+		}
 	};
 	// container for objects ...
-	static std::list<GLApp::GLObject> objects; // singleton
+	static GLObjects objects; // singleton
+
+	// objects updated per job when the update is split across the job system
+	static constexpr size_t UPDATE_GRAIN = 4096;
+	// fence of the jobs updating GLApp::objects, submitted by update();
+	// stages reading the objects' state must wait on it first
+	static GLJobs::Fence update_fence;
 
 
 };
@@ -0,0 +1,58 @@
+/* !
+@file		glbench.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLBench that encapsulates the
+frame-time benchmark suite. The suite replays scripted spawn scenarios through
+the real game loop (GLApp::update and GLApp::draw) by scripting the left mouse
+button clicks that GLApp::update reacts to:
+
+	ramp		clicks that double the objects from 1 up to GLApp::max_objects
+	steady		frames without clicks at every power of two on the way up
+	kill_half	clicks that halve the objects from GLApp::max_objects back to 1
+	sim_cpu		with compare_sim, frames without clicks at every power of
+	sim_gpu		two on the way up, simulated by each backend (see GLGpuSim)
+
+For every frame it records the CPU time of GLApp::update, the CPU time of
+GLApp::draw (submitting the draw calls, including the wait for the update
+jobs) and the GPU time of the frame's stages, as measured by GLProfiler.
+The frames are grouped by scenario and object count and reported as
+p50/p95/p99 percentiles in CSV and/or JSON; GPU times GLProfiler dropped are
+left out of the percentiles.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLBENCH_H
+#define GLBENCH_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <string>
+
+/*  _________________________________________________________________________ */
+struct GLBench
+  /*! GLBench structure to encapsulate the scripted benchmark suite ...
+  */
+{
+  struct Options {
+    unsigned repeat = 3;          // number of ramp/kill_half cycles
+    unsigned settle_frames = 2;   // frames recorded after each click
+    unsigned steady_frames = 120; // frames recorded at each power of two
+    std::string label;            // identifies the build being measured
+    std::string csv_path;         // where to write the CSV report
+    std::string json_path;        // where to write the JSON report
+    bool compare_sim = false;     // also run the steady frames on both
+                                  // simulation backends; needs GPU culling
+  };
+
+  // Run the scenarios and write the reports. If neither csv_path nor
+  // json_path is set, the CSV report is printed to std::cout.
+  // Requires GLHelper::init and GLApp::init to have been called with no
+  // objects spawned. Returns false if a report couldn't be written.
+  static bool run(Options const& opt);
+};
+
+#endif /* GLBENCH_H */
@@ -0,0 +1,60 @@
+/* !
+@file		glcamera.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLCamera, a 2D camera that
+maps a rectangle of the world, the view, to NDC.
+
+The view is centred on center and is the world's size divided by zoom, so a
+zoom of 1 shows the whole world as it was shown before there was a camera.
+In the window the camera is panned with W, A, S, D or the arrow keys and
+zoomed about the centre of the view with the mouse wheel (see update()).
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLCAMERA_H
+#define GLCAMERA_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+
+/*  _________________________________________________________________________ */
+struct GLCamera
+  /*! GLCamera structure to encapsulate the world-to-view camera ...
+  */
+{
+  static constexpr GLfloat MIN_ZOOM = 0.5f;
+  static constexpr GLfloat MAX_ZOOM = 64.0f;
+  // zoom factor of one notch of the mouse wheel
+  static constexpr GLfloat ZOOM_STEP = 1.25f;
+  // pan speed, in widths of the view per second
+  static constexpr GLfloat PAN_SPEED = 0.5f;
+
+  glm::vec2 world_size;     // size of the world shown at a zoom of 1
+  glm::vec2 center;         // world coordinates of the centre of the view
+  GLfloat zoom;
+
+  GLCamera() : world_size(1.0f), center(0.0f), zoom(1.0f) {}
+
+  // show the whole world of the given size, centred at the origin
+  void reset(glm::vec2 size);
+  // pan with the keyboard and zoom with the scroll accumulated in
+  // GLHelper::scroll_offset since the last call, which it consumes
+  void update(GLdouble delta_time);
+
+  // half the size of the view in world coordinates
+  glm::vec2 half_extent() const;
+  // view rectangle in world coordinates
+  glm::vec2 view_min() const;
+  glm::vec2 view_max() const;
+  // world coordinates map to NDC as world_to_ndc() * p + ndc_offset()
+  glm::vec2 world_to_ndc() const;
+  glm::vec2 ndc_offset() const;
+};
+
+#endif /* GLCAMERA_H */
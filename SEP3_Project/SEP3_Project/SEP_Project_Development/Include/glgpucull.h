@@ -0,0 +1,111 @@
+/* !
+@file		glgpucull.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLGpuCull that culls the
+objects and generates their draw commands on the GPU.
+
+When enabled, GLApp::update no longer culls, sorts or transforms objects: it
+integrates their angles and writes the state of every object, in spawn
+order, to the current region of GLApp::instance_stream, which the compute
+shaders read as a shader storage buffer; or, with GLGpuSim, the states stay
+on the GPU. dispatch() then runs three passes of GROUP_SIZE objects per
+work group, the work groups being laid out in rows since a dispatch may
+have no more than 65535 in a dimension:
+
+	cull-count		count the visible objects of each model per work group
+	cull-scan		one work group turns the counts into the first instance
+					of every work group's visible objects of every model and
+					writes instance_count and base_instance of the draw
+					command of every model
+	cull-compact	every visible object writes its model-to-NDC transform
+					to its instance
+
+The instances of each model are consecutive and in spawn order, as on the
+CPU path. GLApp::draw_instanced then issues one glMultiDrawElementsIndirect
+per model, sourcing its command from command_buffer(), so the CPU cost of
+drawing depends on the number of models but not on the number of objects.
+The models have their own vertex arrays, vertex formats and index types,
+hence one command per call.
+
+The numbers of visible objects are copied to a persistently mapped buffer
+and read INSTANCE_REGIONS frames later, when the GPU is known to be done,
+so reporting them never stalls.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLGPUCULL_H
+#define GLGPUCULL_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+#include <cstddef>
+
+/*  _________________________________________________________________________ */
+struct GLGpuCull
+  /*! GLGpuCull structure to encapsulate GPU culling and indirect drawing ...
+  */
+{
+  // must match GROUP_SIZE and MAX_MODELS of shaders/cull.glsl
+  static constexpr GLuint GROUP_SIZE = 256;
+  static constexpr GLuint MAX_MODELS = 8;
+  // work groups per dimension that every implementation supports (the
+  // minimum of GL_MAX_COMPUTE_WORK_GROUP_COUNT)
+  static constexpr GLuint MAX_GROUPS_X = 65535;
+
+  // state of an object as read by the compute shaders (std430 layout)
+  struct Object {
+    glm::vec2 position;
+    glm::vec2 scaling;
+    GLfloat angle;        // in degrees
+    GLuint model;         // index in GLApp::models
+    GLfloat radius;       // of the bounding circle, in world coordinates
+    GLfloat angle_speed;  // in degrees per second (see GLGpuSim)
+  };
+
+  // indirect draw command of glMultiDrawElementsIndirect
+  struct DrawCommand {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+  };
+
+  // If set before GLApp::init, objects are culled and drawn by the GPU
+  static bool enabled;
+
+  // compile the compute shaders and allocate the buffers for capacity
+  // objects; called before the models are created since their vertex
+  // arrays source the instances from instance_buffer()
+  static void init(size_t capacity);
+  // write the draw command of every model; called once the models exist
+  static void init_models();
+  static void cleanup();
+
+  // buffer of the model-to-NDC transforms of the visible objects
+  static GLuint instance_buffer();
+  // buffer of the draw commands; the command of model m is the m-th
+  // DrawCommand
+  static GLuint command_buffer();
+
+  // cull the count objects at offset in buffer, and fill the instances and
+  // the draw commands; the objects are a ring of capacity objects whose
+  // oldest is at first
+  static void dispatch(GLuint buffer, GLintptr offset, GLuint count, GLuint first, GLuint capacity);
+
+  // dispatch groups work groups of the program in use, as rows of at most
+  // MAX_GROUPS_X; the shaders number them with group_index() of
+  // shaders/object.glsl and skip those past the last
+  static void dispatch_groups(GLuint groups);
+
+  // visible objects of the frame drawn INSTANCE_REGIONS frames ago
+  static GLuint visible_cnt;
+};
+
+#endif /* GLGPUCULL_H */
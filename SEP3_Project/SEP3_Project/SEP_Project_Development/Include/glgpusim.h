@@ -0,0 +1,65 @@
+/* !
+@file		glgpusim.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLGpuSim, the backend that
+simulates the objects on the GPU.
+
+With GPU culling (see GLGpuCull), the CPU backend integrates the objects'
+angles and writes the state of every object to GLApp::instance_stream every
+frame. The GPU backend instead keeps the state of every slot of
+GLApp::objects in a shader storage buffer that stays on the GPU: the CPU
+only uploads the objects spawned since the last frame, and killing objects
+only moves the head of the ring, which reaches the shaders as a uniform.
+update() then integrates the angles with a compute shader, and GPU culling
+builds the transforms of the visible objects from the resident states.
+
+The backends can be switched at any frame with select(); switching back to
+the CPU reads the angles back once.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLGPUSIM_H
+#define GLGPUSIM_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <cstddef>
+
+/*  _________________________________________________________________________ */
+struct GLGpuSim
+  /*! GLGpuSim structure to encapsulate the GPU simulation backend ...
+  */
+{
+  // must match GROUP_SIZE of shaders/sim-update.comp
+  static constexpr GLuint GROUP_SIZE = 256;
+
+  // Set if the GPU backend simulates the objects. If set before
+  // GLApp::init, GPU culling is enabled too and the GPU backend is used
+  // from the start; afterwards, change it with select()
+  static bool enabled;
+
+  // compile the compute shader and allocate the states of capacity slots;
+  // GPU culling must have been initialized
+  static void init(size_t capacity);
+  static void cleanup();
+  // true once init has succeeded
+  static bool available();
+
+  // switch to the GPU backend if gpu is set, or back to the CPU backend;
+  // the update jobs of GLApp::objects must be done
+  static void select(bool gpu);
+
+  // upload the objects spawned since the last call and integrate the
+  // angles of every live object by delta_time
+  static void update(GLdouble delta_time);
+
+  // buffer of the states, one GLGpuCull::Object per slot of GLApp::objects
+  static GLuint object_buffer();
+};
+
+#endif /* GLGPUSIM_H */
@@ -0,0 +1,191 @@
+/* !
+@file		glgrid.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLGrid, a loose uniform grid
+over the bounding circles of objects, used to find the objects in view.
+
+The world is split into cells_x by cells_y cells and each object is stored
+in the cell containing the centre of its bounding circle; objects outside
+the world are stored in the nearest border cell. Every cell keeps the
+bounding box of the circles stored in it, which may reach into neighbouring
+cells, hence loose. The box grows as objects are inserted and is only reset
+when the cell empties, so it stays conservative when objects leave.
+
+Objects are inserted, moved and removed one at a time in O(1), so the grid
+is kept up to date incrementally rather than rebuilt every frame. Ranges of
+objects spawned or killed together are inserted and removed in bulk on the
+job system: the cells are split into one band per thread, a counting sort
+groups the range's objects by band, and every job then links or unlinks
+the objects of its own band, so no two jobs touch the same cell. A bulk
+operation on n objects with T bands costs O(n + T * n / SORT_GRAIN) work in
+all: the histograms of the sort take T counters per SORT_GRAIN objects, and
+every object is otherwise visited a constant number of times. Since a
+bounding circle is centred on the object's rotation centre, rotating an
+object never changes it; only objects that move or change size have to be
+moved.
+
+query() visits the cells that may hold circles overlapping a rectangle.
+Cells whose box is outside the rectangle are skipped, cells whose box is
+inside it are accepted without testing their objects, and the objects of
+the remaining cells are tested one by one.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLGRID_H
+#define GLGRID_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+#include <gljobs.h>
+#include <cstddef>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+struct GLGrid
+  /*! GLGrid structure to encapsulate the spatial index of objects ...
+  */
+{
+  // cover [world_min, world_max] with cells_x by cells_y cells, for objects
+  // numbered [0, capacity)
+  void init(glm::vec2 world_min, glm::vec2 world_max, GLuint cells_x, GLuint cells_y, size_t capacity);
+  // remove every object
+  void clear();
+
+  // object must not be in the grid
+  void insert(GLuint object, glm::vec2 center, GLfloat radius);
+  // insert objects [first, last), none of which may be in the grid;
+  // circle(object, center, radius) sets the circle of each, in parallel
+  template <typename Fn>
+  void insert(GLuint first, GLuint last, Fn circle);
+  // object must be in the grid
+  void remove(GLuint object);
+  // remove objects [first, last), all of which must be in the grid
+  void remove(GLuint first, GLuint last);
+  void move(GLuint object, glm::vec2 center, GLfloat radius);
+
+  // call fn(object) for every object whose bounding circle overlaps the
+  // rectangle [lo, hi]
+  template <typename Fn>
+  void query(glm::vec2 lo, glm::vec2 hi, Fn fn) const;
+
+private:
+  struct Cell {
+    std::vector<GLuint> objects;
+    glm::vec2 lo, hi;         // bounding box of the circles stored in the cell
+  };
+
+  static constexpr GLuint NONE = ~0u;
+
+  std::vector<Cell> cells;
+  // per object: circle, cell and position within the cell's objects
+  std::vector<glm::vec2> centers;
+  std::vector<GLfloat> radii;
+  std::vector<GLuint> cell_of, index_in_cell;
+
+  glm::vec2 origin;
+  glm::vec2 inv_cell_size;
+  GLuint cells_x = 0, cells_y = 0;
+  GLfloat max_radius = 0.0f;  // largest radius since the grid was last empty
+  size_t count = 0;
+
+  // objects whose circles are set per job by the bulk insert
+  static constexpr size_t INSERT_GRAIN = 4096;
+  // objects counted and scattered per job by sort_by_band
+  static constexpr size_t SORT_GRAIN = 4096;
+
+  // the cells are split into bands of cells_per_band consecutive cells;
+  // sort_by_band leaves the objects of band b of a bulk operation in
+  // by_band[band_start[b], band_start[b + 1]), in increasing order
+  size_t bands = 1, cells_per_band = 1;
+  std::vector<GLuint> by_band;
+  std::vector<size_t> band_start;
+  // objects of each band in each chunk of SORT_GRAIN objects, then where
+  // the chunk's objects of the band go in by_band
+  std::vector<size_t> chunk_offsets;
+
+  GLuint column(GLfloat x) const;
+  GLuint row(GLfloat y) const;
+  GLuint cell_index(glm::vec2 center) const;
+  // group objects [first, last), whose cells are set, by band
+  void sort_by_band(GLuint first, GLuint last);
+  // append objects [first, last), whose circles and cells are set, to
+  // their cells
+  void link(GLuint first, GLuint last);
+  // take object out of its cell
+  void unlink(GLuint object);
+};
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::insert(GLuint first, GLuint last, Fn circle)
+
+@brief
+	This function sets the circles and cells of objects [first, last) in
+	parallel, then links the objects into their cells.
+
+@return none
+*/
+template <typename Fn>
+void GLGrid::insert(GLuint first, GLuint last, Fn circle)
+{
+  GLJobs::Fence fence;
+  GLJobs::parallel_for(first, last, INSERT_GRAIN, [this, &circle](size_t b, size_t e) {
+    for (size_t i = b; i < e; i++) {
+      GLuint const object = static_cast<GLuint>(i);
+      circle(object, centers[object], radii[object]);
+      cell_of[object] = cell_index(centers[object]);
+    }
+  }, fence);
+  GLJobs::wait(fence);
+  link(first, last);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::query(glm::vec2 lo, glm::vec2 hi, Fn fn) const
+
+@brief
+	This function calls fn(object) for every object whose bounding circle
+	overlaps the rectangle [lo, hi]. A circle is stored in the cell of its
+	centre, so only the cells of centres within max_radius of the rectangle
+	are visited.
+
+@return none
+*/
+template <typename Fn>
+void GLGrid::query(glm::vec2 lo, glm::vec2 hi, Fn fn) const
+{
+  if (count == 0) {
+    return;
+  }
+  GLuint const x0 = column(lo.x - max_radius), x1 = column(hi.x + max_radius);
+  GLuint const y0 = row(lo.y - max_radius), y1 = row(hi.y + max_radius);
+
+  for (GLuint y = y0; y <= y1; y++) {
+    for (GLuint x = x0; x <= x1; x++) {
+      Cell const& cell = cells[y * cells_x + x];
+      if (cell.objects.empty() ||
+          cell.hi.x < lo.x || cell.lo.x > hi.x || cell.hi.y < lo.y || cell.lo.y > hi.y) {
+        continue;
+      }
+      if (cell.lo.x >= lo.x && cell.hi.x <= hi.x && cell.lo.y >= lo.y && cell.hi.y <= hi.y) {
+        for (GLuint object : cell.objects) {
+          fn(object);
+        }
+        continue;
+      }
+      for (GLuint object : cell.objects) {
+        glm::vec2 const d = centers[object] - glm::clamp(centers[object], lo, hi);
+        if (glm::dot(d, d) <= radii[object] * radii[object]) {
+          fn(object);
+        }
+      }
+    }
+  }
+}
+
+#endif /* GLGRID_H */
@@ -29,7 +29,16 @@ struct GLHelper
   /*! GLHelper structure to encapsulate initialization stuff ...
   */
 {
-  static bool init(GLint w, GLint h, std::string t);
+  // With offscreen set, no visible window is created: rendering goes into
+  // offscreen_fbo, which is bound as the default framebuffer of the context.
+  // The context still belongs to an invisible GLFW window, so a display is
+  // still needed: a desktop session on Windows, or an X server on Linux
+  // (for instance Xvfb, through "xvfb-run -a"). Defining GLHELPER_EGL makes
+  // offscreen contexts surfaceless EGL contexts, which need neither a
+  // display server nor GLFW, but it takes a Linux build linking libEGL and
+  // a GLEW built with GLEW_EGL, neither of which the Visual Studio project
+  // provides.
+  static bool init(GLint w, GLint h, std::string t, bool offscreen = false);
   static void cleanup();
 
   // callbacks ...
@@ -42,12 +51,17 @@ struct GLHelper
   static void mousepos_cb(GLFWwindow *pwin, double xpos, double ypos);
 
   static void update_time(double fpsCalcInt = 1.0);
+  // seconds elapsed since the context was created
+  static double time();
 
   static GLint width, height;			// Width and height of the window.
   static GLdouble fps;					// FPS of the window
   static GLdouble delta_time;			// time taken to complete most recent game loop
   static std::string title;				// Title of the window
   static GLFWwindow *ptr_window;		// the pointer of the window client.
+  static bool headless;					// true if rendering offscreen
+  static GLuint offscreen_fbo;			// framebuffer rendered into when headless
+  static GLuint offscreen_color;		// color renderbuffer of offscreen_fbo
 
   /*  _________________________________________________________________________ */
   /*! parameters
@@ -59,7 +73,9 @@ struct GLHelper
   static std::vector<bool> mouseStates;
 
   static GLboolean keystateP;			// keystate boolean for 'P' Key
+  static GLboolean keystateG;			// keystate boolean for 'G' Key
   static GLboolean LMouseState;			// Mouse state boolean for 'L Mouse Button/Mouse Button 1' 
+  static GLdouble scroll_offset;		// vertical scroll not yet consumed by GLCamera::update
   static void print_specs();
 };
 
@@ -0,0 +1,53 @@
+/* !
+@file		glhud.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLHud that encapsulates the
+on-screen stats overlay. Text is turned into quads with stb_easy_font and the
+quads are rendered into the framebuffer with a single indexed draw call.
+
+The quads are only regenerated and uploaded when new text is set, which the
+application does every refresh_interval seconds; in between, the overlay is
+redrawn from the buffer it already has. All buffers are allocated in init(),
+so neither setting text nor drawing allocates memory.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLHUD_H
+#define GLHUD_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <cstddef>
+
+/*  _________________________________________________________________________ */
+struct GLHud
+  /*! GLHud structure to encapsulate the stats overlay ...
+  */
+{
+  // maximum number of quads in the overlay; stb_easy_font needs at most
+  // about four quads per character
+  static constexpr size_t MAX_QUADS = 4096;
+  // maximum length of the overlay text
+  static constexpr size_t MAX_TEXT = 1024;
+
+  static void init();
+  static void cleanup();
+
+  // true if refresh_interval seconds have passed since the text was last
+  // set, that is, if the application should format and set new text
+  static bool due();
+  // generate and upload the quads of text; lines are separated by '\n'
+  static void set_text(char const* text);
+  // render the overlay over the current framebuffer
+  static void draw();
+
+  static double refresh_interval;   // seconds between text updates
+  static GLfloat scale;             // size of the text relative to stb_easy_font's
+};
+
+#endif /* GLHUD_H */
@@ -0,0 +1,74 @@
+/* !
+@file		gljobs.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLJobs that encapsulates a
+small job system: a pool of worker threads, each owning a work-stealing
+queue, to which stages of the game loop submit jobs and parallel-for ranges.
+
+Every thread that runs jobs owns a queue. Jobs submitted by a thread are
+pushed onto its own queue; the owner pops from the back (newest first) while
+idle threads steal from the front (oldest first) of other queues. A submission
+is tracked by a Fence that counts its outstanding jobs, so later stages can
+depend on earlier ones by waiting on their fences. Waiting threads help by
+running queued jobs instead of blocking.
+
+A submission keeps its job or range function in a recycled record, and its
+chunks are queued as fixed-size tasks (a function pointer, the record and a
+range) in ring buffers that keep their capacity, so submitting allocates
+nothing once the pool has warmed up.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLJOBS_H
+#define GLJOBS_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+/*  _________________________________________________________________________ */
+struct GLJobs
+  /*! GLJobs structure to encapsulate the worker pool and its queues ...
+  */
+{
+  // Counts the outstanding jobs of one or more submissions. A fence is done
+  // when all jobs submitted against it have finished. The fence must outlive
+  // the jobs submitted against it.
+  struct Fence {
+    std::atomic<size_t> pending{ 0 };
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+  };
+
+  using Job = std::function<void()>;
+  using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+  // start worker_cnt worker threads; 0 selects one less than the number of
+  // hardware threads so that together with the calling thread every core
+  // is busy
+  static void init(unsigned worker_cnt = 0);
+  // finish all queued jobs and join the worker threads
+  static void cleanup();
+
+  // number of threads running jobs: the workers plus the thread that
+  // called init()
+  static unsigned thread_count();
+
+  // queue one job against fence
+  static void submit(Job job, Fence& fence);
+
+  // split [begin, end) into chunks of at most grain elements and queue one
+  // fn(chunk_begin, chunk_end) job per chunk against fence
+  static void parallel_for(size_t begin, size_t end, size_t grain, RangeFn fn, Fence& fence);
+
+  // run queued jobs until fence is done
+  static void wait(Fence& fence);
+};
+
+#endif /* GLJOBS_H */
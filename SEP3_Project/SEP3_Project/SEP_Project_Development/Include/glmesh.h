@@ -0,0 +1,122 @@
+/* !
+@file		glmesh.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLMesh that encapsulates a
+mesh loaded through a binary cache of DPML::parse_obj_mesh's output.
+
+The first load of an OBJ file parses it with DPML::parse_obj_mesh, optionally
+optimizes it with GLMeshOpt and writes the resulting arrays into a cache file
+next to it (the OBJ's path with
+".dpmb" appended). Later loads memory-map the cache file and hand out spans
+that point straight into the mapping, so nothing is parsed or copied.
+
+The cache records the OBJ file's modification time, size and 64-bit FNV-1a
+hash. If the time or size no longer match, the OBJ file is hashed: an equal
+hash means the file was only touched, and the cache is kept (with the new
+time recorded); a different hash, or a cache written for other load flags,
+means the OBJ file is parsed again and the cache rewritten. Cache files are
+written under a temporary name and then renamed over the old one in a
+single step, so a reader, or a run after a crash, finds either the old
+cache or the whole new one. If the cache can't be written, the mesh is
+served from memory instead.
+
+Cache file layout (little endian, every array aligned to 16 bytes):
+
+	Header		magic "DPMB", version, flags, source time/size/hash,
+				vertex and index counts and the offset of every array
+	positions	vertex_cnt glm::vec3
+	normals		vertex_cnt glm::vec3 (if the NORMALS flag is set)
+	texcoords	vertex_cnt glm::vec2 (if the TEXCOORDS flag is set)
+	triangles	index_cnt GLushort, or GLuint if there are more than 65536
+				vertices
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLMESH_H
+#define GLMESH_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+struct GLMesh
+  /*! GLMesh structure to encapsulate a memory-mapped cached mesh ...
+  */
+{
+  // read-only view of count elements owned by the mapping
+  template <typename T>
+  struct Span {
+    T const* ptr = nullptr;
+    size_t count = 0;
+
+    T const* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T const* begin() const { return ptr; }
+    T const* end() const { return ptr + count; }
+    T const& operator[](size_t i) const { return ptr[i]; }
+  };
+
+  // load flags, also recorded in the cache header
+  enum Flags : std::uint32_t {
+    NORMALS = 1u << 0,      // load or compute per-vertex normals
+    TEXCOORDS = 1u << 1,    // load texture coordinates
+    CENTERED = 1u << 2,     // centre the bounding box at the origin
+    OPTIMIZE = 1u << 3,     // reorder for vertex cache and fetch locality
+    OVERDRAW = 1u << 4      // with OPTIMIZE, also sort triangles to reduce overdraw
+  };
+
+  static constexpr std::uint32_t VERSION = 2;
+
+  Span<glm::vec3> positions;
+  Span<glm::vec3> normals;      // empty unless loaded with NORMALS
+  Span<glm::vec2> texcoords;    // empty unless loaded with TEXCOORDS
+  // three indices into the arrays per triangle, stored as 16-bit indices
+  // if every vertex can be indexed with them and as 32-bit ones otherwise
+  GLenum index_type;            // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+  Span<GLushort> triangles16;   // if index_type is GL_UNSIGNED_SHORT
+  Span<GLuint> triangles32;     // if index_type is GL_UNSIGNED_INT
+  bool parsed;                  // true if the OBJ file had to be parsed
+
+  GLMesh() : index_type(GL_UNSIGNED_SHORT), parsed(false), map_addr(nullptr), map_size(0) {}
+  ~GLMesh() { unload(); }
+  GLMesh(GLMesh const&) = delete;
+  GLMesh& operator=(GLMesh const&) = delete;
+
+  // load obj_path with the given Flags through its cache; returns false if
+  // the OBJ file is missing or can't be parsed
+  bool load(std::string const& obj_path, std::uint32_t flags = NORMALS | CENTERED | OPTIMIZE);
+  // unmap the cache and free the in-memory image; the spans become empty
+  void unload();
+
+  // number of triangle indices, their size in bytes and their data
+  size_t index_cnt() const;
+  size_t index_size() const;
+  void const* index_data() const;
+  // triangle index i, whatever the index type
+  GLuint index(size_t i) const;
+
+  // smallest index type able to index vertex_cnt vertices
+  static GLenum index_type_for(size_t vertex_cnt);
+
+private:
+  void* map_addr;               // mapping of the cache file
+  size_t map_size;
+  std::vector<std::uint8_t> image;  // cache contents if the file can't be used
+
+  bool map(std::string const& cache_path);
+  void unmap();
+  bool attach(std::uint8_t const* base, size_t size);
+};
+
+#endif /* GLMESH_H */
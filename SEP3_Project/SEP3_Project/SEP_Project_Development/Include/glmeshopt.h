@@ -0,0 +1,98 @@
+/* !
+@file		glmeshopt.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLMeshOpt that encapsulates
+the load-time optimization of indexed triangle meshes. Meshes come out of
+DPML::parse_obj_mesh in file order, which modelling tools rarely arrange for
+the GPU. The passes are:
+
+	optimize_vertex_cache	reorder triangles so that vertices are reused
+							while they are still in the post-transform cache
+							(Tom Forsyth, "Linear-Speed Vertex Cache
+							Optimisation")
+	optimize_overdraw		split the triangle order into clusters where the
+							cache restarts and sort the clusters front to
+							back, outward-facing first, so that early depth
+							testing rejects more fragments (after Sander et
+							al., "Fast Triangle Reordering for Vertex
+							Locality and Reduced Overdraw")
+	optimize_vertex_fetch	renumber vertices in the order the triangles
+							first use them, so vertex fetches walk memory
+							forwards
+
+Their effect is measured by simulating a FIFO post-transform cache:
+
+	ACMR	average cache miss ratio: vertex shader invocations per triangle
+			(0.5 is the ideal for large regular meshes, 3 the worst)
+	ATVR	average transformed vertex ratio: vertex shader invocations per
+			vertex (1 is the ideal)
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLMESHOPT_H
+#define GLMESHOPT_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+struct GLMeshOpt
+  /*! GLMeshOpt structure to encapsulate the mesh optimization passes ...
+  */
+{
+  struct CacheStats {
+    float acmr;
+    float atvr;
+  };
+
+  // size of the FIFO cache simulated by analyze(), typical of the
+  // post-transform caches of current GPUs
+  static constexpr size_t ANALYSIS_CACHE_SIZE = 16;
+  // size of the LRU cache modelled by optimize_vertex_cache()
+  static constexpr size_t OPTIMIZE_CACHE_SIZE = 32;
+
+  // simulate a FIFO post-transform cache of cache_size vertices
+  static CacheStats analyze(std::vector<GLuint> const& indices, size_t vertex_cnt,
+                            size_t cache_size = ANALYSIS_CACHE_SIZE);
+
+  // reorder the triangles of indices for post-transform cache locality
+  static void optimize_vertex_cache(std::vector<GLuint>& indices, size_t vertex_cnt);
+
+  // sort the clusters of an optimize_vertex_cache()d triangle order to
+  // reduce overdraw
+  static void optimize_overdraw(std::vector<GLuint>& indices, std::vector<glm::vec3> const& positions);
+
+  // renumber the vertices in order of first use; returns the new index of
+  // every old vertex, to be passed to remap() for every vertex attribute
+  static std::vector<GLuint> optimize_vertex_fetch(std::vector<GLuint>& indices, size_t vertex_cnt);
+
+  // reorder attribs so that element i moves to position new_index[i]
+  template <typename T>
+  static void remap(std::vector<T>& attribs, std::vector<GLuint> const& new_index) {
+    if (attribs.empty()) {
+      return;
+    }
+    std::vector<T> reordered(attribs.size());
+    for (size_t i = 0; i < attribs.size(); i++) {
+      reordered[new_index[i]] = attribs[i];
+    }
+    attribs.swap(reordered);
+  }
+
+  // Run every pass (optimize_overdraw only if overdraw is set) on a mesh
+  // and print its ACMR and ATVR before and after to report, if not null.
+  static void optimize(std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals,
+                       std::vector<glm::vec2>& texcoords, std::vector<GLuint>& indices,
+                       bool overdraw, std::ostream* report);
+};
+
+#endif /* GLMESHOPT_H */
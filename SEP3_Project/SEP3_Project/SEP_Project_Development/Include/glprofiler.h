@@ -0,0 +1,99 @@
+/* !
+@file		glprofiler.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLProfiler that encapsulates
+scoped CPU and GPU timing of the stages of a frame.
+
+A stage is timed by constructing a GLProfiler::Scope at its start. The scope
+measures the CPU time until it is destroyed and, unless it is CPU only,
+brackets the stage's commands with two glQueryCounter(GL_TIMESTAMP) queries.
+Queries come from a ring holding FRAMES_IN_FLIGHT frames' worth of query
+objects. A frame's results are collected when its part of the ring is
+reused, and only if GL_QUERY_RESULT_AVAILABLE says they are ready, so
+reading them never stalls the pipeline; results that aren't ready by then
+are dropped and counted.
+
+The CPU and GPU times of every stage are averaged over the last WINDOW
+frames. The GPU time of every frame whose results are all collected is also
+passed to frame_listener, if set, so that per-frame GPU times (see GLBench)
+come from the same queries.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLPROFILER_H
+#define GLPROFILER_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/*  _________________________________________________________________________ */
+struct GLProfiler
+  /*! GLProfiler structure to encapsulate CPU and GPU stage timing ...
+  */
+{
+  // number of frames whose queries may be in flight at the same time
+  static constexpr GLuint FRAMES_IN_FLIGHT = 4;
+  // maximum number of distinct stages, and of timed scopes per frame
+  static constexpr size_t MAX_STAGES = 16;
+  // number of frames the rolling averages are taken over
+  static constexpr size_t WINDOW = 64;
+
+  // Times the stage called name from construction to destruction. name
+  // must be a string literal (or otherwise outlive the profiler). With gpu
+  // unset only the CPU time is measured.
+  struct Scope {
+    Scope(char const* name, bool gpu = true);
+    ~Scope();
+
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+    size_t stage;
+    GLint query;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  static void init();
+  static void cleanup();
+
+  // start a new frame: collects the results of the frame that last used
+  // this frame's part of the query ring
+  static void begin_frame();
+  // number of the current frame; begin_frame starts frame 1
+  static std::uint64_t frame_number();
+  // wait for the GPU and collect the results of every frame still in
+  // flight, at the end of a run
+  static void flush();
+
+  // called with the number and the GPU time of all stages, in
+  // milliseconds, of every frame whose results were all available
+  using FrameListener = void (*)(std::uint64_t frame, double gpu_ms);
+  static FrameListener frame_listener;
+
+  // stages in the order they were first timed
+  static size_t stage_count();
+  static char const* stage_name(size_t stage);
+  // rolling average times of a stage, in milliseconds; gpu_ms is 0 for
+  // CPU only stages
+  static double cpu_ms(size_t stage);
+  static double gpu_ms(size_t stage);
+  // rolling average GPU time of all stages of a frame, in milliseconds
+  static double gpu_frame_ms();
+
+  // number of GPU results that weren't available in time and were dropped
+  static GLuint dropped_cnt();
+
+  // print the rolling averages of every stage
+  static void report(std::ostream& os);
+};
+
+#endif /* GLPROFILER_H */
@@ -0,0 +1,73 @@
+/* !
+@file		glrandom.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLRandom, a counter-based
+random number generator.
+
+A number is not the next state of an engine but a pure function of the
+seed, a stream and a counter: bits() hashes the stream's key plus the
+counter times the golden ratio with the SplitMix64 finalizer. No state is
+shared or carried from one number to the next, so any thread can draw any
+number of any stream, in any order, and always gets the same value. Object
+N, for instance, draws number N (or 2N and 2N + 1 for a vec2) of the stream
+of each of its attributes, whichever thread initializes it.
+
+uniform_floats() fills arrays with an AVX2 kernel (eight floats per
+iteration) or, on 32-bit x86, an SSE2 one (four), on the instruction set
+selected for GLXform; the 64-bit multiplies of the mix are built from
+32x32-bit ones, which both have. Every path draws exactly the same floats.
+
+The seed is set once, before anything is drawn; unless it is given on the
+command line ("--seed N"), each run picks one from std::random_device.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLRANDOM_H
+#define GLRANDOM_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <cstddef>
+#include <cstdint>
+
+/*  _________________________________________________________________________ */
+struct GLRandom
+  /*! GLRandom structure to encapsulate the counter-based generator ...
+  */
+{
+  // increment of the Weyl sequence hashed by bits(), 2^64 / golden ratio
+  static constexpr std::uint64_t GOLDEN = 0x9E3779B97F4A7C15ull;
+
+  // seed of every stream
+  static std::uint64_t seed;
+
+  // SplitMix64 finalizer: a bijection of 64-bit values whose outputs for
+  // consecutive inputs look independent
+  static std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  // key of stream under the current seed
+  static std::uint64_t key(std::uint64_t stream) {
+    return mix(seed + mix(stream + GOLDEN));
+  }
+
+  // 64 random bits, the number counter of the stream with the given key
+  static std::uint64_t bits(std::uint64_t key, std::uint64_t counter) {
+    return mix(key + (counter + 1) * GOLDEN);
+  }
+
+  // fill out with numbers [counter, counter + count) of stream, as floats
+  // uniformly distributed in [min, max)
+  static void uniform_floats(std::uint64_t stream, std::uint64_t counter,
+    GLfloat* out, size_t count, GLfloat min, GLfloat max);
+};
+
+#endif /* GLRANDOM_H */
@@ -0,0 +1,87 @@
+/* !
+@file		glrenderqueue.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLRenderQueue, the per-frame
+list of draw packets that decides the order in which objects are drawn.
+
+Every visible object pushes a packet holding its slot in GLApp::objects and a
+64-bit sort key packing the state it is drawn with, most significant first:
+
+	bits 63..48		shader program (index in GLApp::shdrpgms)
+	bits 47..32		model (index in GLApp::models)
+	bits 31..24		material
+	bits 23..0		depth
+
+sort() orders the packets by key with a stable LSD radix sort, so objects
+sharing a program end up together, then objects sharing a model, and so on,
+and then merges consecutive packets whose keys differ only in depth into
+runs. A run is drawn with a single instanced draw call whose instances are
+the run's packets, in sorted order; depth only orders the instances within
+a run. The i-th sorted packet is the i-th instance of the frame.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLRENDERQUEUE_H
+#define GLRENDERQUEUE_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+struct GLRenderQueue
+  /*! GLRenderQueue structure to encapsulate the sorted draw packets ...
+  */
+{
+  using Key = std::uint64_t;
+
+  static constexpr unsigned DEPTH_BITS = 24;
+  static constexpr unsigned MATERIAL_BITS = 8;
+  static constexpr unsigned MODEL_BITS = 16;
+  static constexpr unsigned SHADER_BITS = 16;
+  static constexpr unsigned MATERIAL_SHIFT = DEPTH_BITS;
+  static constexpr unsigned MODEL_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+  static constexpr unsigned SHADER_SHIFT = MODEL_SHIFT + MODEL_BITS;
+
+  // key of an object; every field is truncated to its number of bits
+  static Key make_key(GLuint shader, GLuint model, GLuint material, GLuint depth);
+  static GLuint shader(Key key);
+  static GLuint model(Key key);
+  static GLuint material(Key key);
+
+  struct Packet {
+    Key key;
+    GLuint object;          // slot in GLApp::objects
+  };
+
+  // packets [first, first + count) after sort(), drawn with one call
+  struct Run {
+    Key key;                // key of the first packet
+    GLuint first;
+    GLuint count;
+  };
+
+  std::vector<Packet> packets;
+  std::vector<Run> runs;
+
+  // allocate for capacity packets so that push() never allocates
+  void reserve(size_t capacity);
+  // drop the packets and runs of the previous frame
+  void clear();
+  void push(Key key, GLuint object) { packets.push_back(Packet{ key, object }); }
+  // sort the packets by key, keeping packets with equal keys in push
+  // order, and build the runs
+  void sort();
+
+private:
+  std::vector<Packet> scratch;
+};
+
+#endif /* GLRENDERQUEUE_H */
@@ -0,0 +1,75 @@
+/* !
+@file		glshaderwatch.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLShaderWatch that watches
+the source files of shader programs on a background thread, for hot reload.
+
+When a watched file changes, the thread waits until the files have been
+quiet for SETTLE_MS (editors often save in several writes, or by writing a
+temporary file and renaming it), then reads and preprocesses the sources of
+every program using the file with GLSLShader::ReadSources and queues them.
+Files an edit starts to #include are watched from then on.
+The render thread collects the queued sources with pop() at a frame
+boundary and builds the new program itself, since only it may call OpenGL
+(see GLApp::reload_shdrpgms).
+
+On Linux the thread sleeps on inotify, watching the directories of the files
+rather than the files so that saves by rename are seen. Elsewhere it polls
+the files' modification times and sizes every POLL_MS.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLSHADERWATCH_H
+#define GLSHADERWATCH_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+struct GLShaderWatch
+  /*! GLShaderWatch structure to encapsulate the shader file watcher ...
+  */
+{
+  using Files = std::vector<std::pair<GLenum, std::string>>;
+
+  // shader files of one program, the names #define'd in its sources and
+  // the files they include (see GLSLShader::IncludedFiles)
+  struct Program {
+    Files files;
+    std::vector<std::string> defines;
+    std::vector<std::string> includes;
+  };
+
+  // new sources of program number program, or why they couldn't be read,
+  // and the files it includes now; those are watched from then on
+  struct Update {
+    size_t program;
+    bool ok;
+    Files sources;
+    std::string log;
+    std::vector<std::string> includes;
+  };
+
+  static constexpr unsigned SETTLE_MS = 50;
+  static constexpr unsigned POLL_MS = 250;
+
+  // start watching the files of programs; updates refer to programs by
+  // their index in programs
+  static void start(std::vector<Program> const& programs);
+  // stop and join the thread; updates not popped yet are dropped
+  static void stop();
+
+  // take the oldest queued update; false if there is none
+  static bool pop(Update& update);
+};
+
+#endif /* GLSHADERWATCH_H */
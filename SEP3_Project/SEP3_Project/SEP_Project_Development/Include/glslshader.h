@@ -28,6 +28,8 @@ program object.
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
 
 /*  _________________________________________________________________________ */
@@ -50,7 +52,61 @@ public:
   // CompileShaderFromFile(). After the shader objects are created, a call to
   // Link() will create a shader executable program. This is followed by a call
   // to Validate() ensuring the program can execute in the current OpenGL state.
-  GLboolean CompileLinkValidate(std::vector<std::pair<GLenum, std::string>>);
+  // Each name in defines is #define'd at the top of every shader source.
+  // If binary_cache_dir isn't empty, a program linked before from the same
+  // sources, defines and driver is reloaded from its binary instead (see
+  // LoadProgramBinary); any failure falls back to compiling the sources.
+  GLboolean CompileLinkValidate(std::vector<std::pair<GLenum, std::string>>,
+                                std::vector<std::string> const& defines = {});
+
+  // directory, ending with a separator, where CompileLinkValidate saves
+  // linked program binaries, created when the first one is saved; empty
+  // disables the cache. Binaries of another driver or layout version are
+  // deleted once a program has been linked from sources (see
+  // PruneBinaryCache)
+  static std::string binary_cache_dir;
+
+  // CompileLinkValidate in three steps, for callers that must not wait for
+  // the driver (see GLApp::reload_shdrpgms). ReadSources reads the files
+  // and injects defines without calling OpenGL, so it may run on any
+  // thread. StartBuild submits the compilation and link of the sources to
+  // a new program object and returns without waiting for them, or fails
+  // with no program or shader left behind if a type is invalid; FinishBuild
+  // then reports whether the program linked, with the compiler's or
+  // linker's messages in the log.
+  // With GL_KHR_parallel_shader_compile (or the ARB version) the driver
+  // builds on its own threads and IsBuildComplete tells, without blocking,
+  // when FinishBuild will return at once. Without it IsBuildComplete
+  // always returns GL_TRUE and FinishBuild may wait.
+  static GLboolean ReadSources(std::vector<std::pair<GLenum, std::string>> const& files,
+                               std::vector<std::string> const& defines,
+                               std::vector<std::pair<GLenum, std::string>>& sources,
+                               std::string& log);
+  GLboolean StartBuild(std::vector<std::pair<GLenum, std::string>> const& sources);
+  GLboolean FinishBuild();
+  GLboolean IsBuildComplete() const;
+
+  // Finish and validate a batch of programs whose builds were started
+  // with StartBuild, in the order they complete; GL_FALSE if any failed,
+  // with the reason in its log. Submitting every program before finishing
+  // any lets the driver compile them in parallel, and lets the caller do
+  // other work in between.
+  static GLboolean FinishBuilds(std::vector<GLSLShader*> const& shaders);
+
+  // Shader files may #include "file" other files, which are looked up in
+  // the directory of the file given to CompileLinkValidate. IncludedFiles
+  // lists the paths of every file file_name includes, directly or not.
+  static std::vector<std::string> IncludedFiles(std::string const& file_name);
+
+  // Variants of a shader are selected by a permutation key whose bits each
+  // #define a name that the sources test with #ifdef; PermutationDefines
+  // returns the names to pass to CompileLinkValidate for a key.
+  using Permutation = unsigned;
+  enum : Permutation {
+    INSTANCED = 1u << 0,      // model-to-NDC transform per instance, not uniform
+    QUANTIZED_POS = 1u << 1   // positions decoded with uPosDecode (see GLVertexFormat)
+  };
+  static std::vector<std::string> PermutationDefines(Permutation key);
 
   // This function does the following:
   // 1) Create a shader program object if one doesn't exist
@@ -79,6 +135,8 @@ public:
   // If the shader objects did not link into a program object, then the
   // member function must retrieve and write the program object's information
   // log to data member log_string. 
+  // After a successful link, every active uniform is reflected once into a
+  // hashed name->location table so that no later lookup reaches the driver.
   GLboolean Link();
 
   // Install the shader program object whose handle is encapsulated
@@ -129,10 +187,40 @@ public:
   // as the name implies, this function deletes a program object
   void DeleteShaderProgram();
 
+  // Pre-resolved handle to a uniform variable of type T. Handles are
+  // obtained once with GetUniform<T>() after Link() and passed to the
+  // SetUniform overloads below, so hot paths never look up a name.
+  // A handle to a uniform that isn't active (or whose type doesn't match T)
+  // is invalid and setting it does nothing.
+  template <typename T>
+  struct Uniform {
+    GLint loc = -1;
+    bool IsValid() const { return loc >= 0; }
+  };
+
+  // Resolve a handle to the active uniform "name" of type T. A uniform that
+  // doesn't exist, or whose type doesn't match T, is reported once here.
+  template <typename T>
+  Uniform<T> GetUniform(GLchar const* name) {
+    return Uniform<T>{ ResolveUniform(name, UniformType(static_cast<T*>(nullptr))) };
+  }
+
+  // Set the value of a pre-resolved uniform of the current program object
+  void SetUniform(Uniform<GLboolean> u, GLboolean val);
+  void SetUniform(Uniform<GLint> u, GLint val);
+  void SetUniform(Uniform<GLfloat> u, GLfloat val);
+  void SetUniform(Uniform<glm::vec2> u, glm::vec2 const& val);
+  void SetUniform(Uniform<glm::vec3> u, glm::vec3 const& val);
+  void SetUniform(Uniform<glm::vec4> u, glm::vec4 const& val);
+  void SetUniform(Uniform<glm::mat3> u, glm::mat3 const& val);
+  void SetUniform(Uniform<glm::mat4> u, glm::mat4 const& val);
+
   // OpenGL is C-based API and therefore doesn't understand function
   // overloading or templates
   // Therefore, we need a family of functions to specify values of uniform
   // variables of different types for the current program object
+  // These overloads look the name up in the table built by Link(); a name
+  // that isn't an active uniform is reported once, not on every call.
   void SetUniform(GLchar const* name, GLboolean val);
   void SetUniform(GLchar const* name, GLint val);
   void SetUniform(GLchar const* name, GLfloat val);
@@ -158,22 +246,77 @@ private:
     GEOMETRY_SHADER = GL_GEOMETRY_SHADER,
     TESS_CONTROL_SHADER = GL_TESS_CONTROL_SHADER,
     TESS_EVALUATION_SHADER = GL_TESS_EVALUATION_SHADER,
-    // ignore compute shader for now because it is not connected to
-    // the graphics pipe
-    // COMPUTE_SHADER = GL_COMPUTE_SHADER
+    // not connected to the graphics pipe; a program holding it must hold
+    // no other stage
+    COMPUTE_SHADER = GL_COMPUTE_SHADER
   };
 
   GLuint pgm_handle = 0;  // handle to linked shader program object
   GLboolean is_linked = GL_FALSE; // has the program successfully linked?
   std::string log_string; // log for OpenGL compiler and linker messages
 
+  // location and type of an active uniform variable
+  struct UniformInfo {
+    GLint loc;
+    GLenum type;
+  };
+  // active uniforms reflected by Link(), keyed by name
+  std::unordered_map<std::string, UniformInfo> uniforms;
+  // names already reported as missing, so each is reported only once
+  std::unordered_set<std::string> missing_uniforms;
+  // shader objects and binary cache path of a build between StartBuild
+  // and FinishBuild
+  std::vector<GLuint> pending_shaders;
+  std::string pending_cache_path;
+
 private:
-  // use OpenGL API to return the location of an uniform variable with
-  // name "name" using program handle encapsulated by object of this class type
+  // return the location of an uniform variable with name "name" from the
+  // table built by Link(); -1 (reported once) if it isn't active
   GLint GetUniformLocation(GLchar const* name);
 
+  // query every active uniform of the linked program into "uniforms"
+  void ReflectUniforms();
+
+  // location of active uniform "name" if its type is "type", -1 otherwise;
+  // a missing or mismatched uniform is reported once
+  GLint ResolveUniform(GLchar const* name, GLenum type);
+
+  // GLSL type of the uniforms handled by Uniform<T>
+  static GLenum UniformType(GLboolean*) { return GL_BOOL; }
+  static GLenum UniformType(GLint*) { return GL_INT; }
+  static GLenum UniformType(GLfloat*) { return GL_FLOAT; }
+  static GLenum UniformType(glm::vec2*) { return GL_FLOAT_VEC2; }
+  static GLenum UniformType(glm::vec3*) { return GL_FLOAT_VEC3; }
+  static GLenum UniformType(glm::vec4*) { return GL_FLOAT_VEC4; }
+  static GLenum UniformType(glm::mat3*) { return GL_FLOAT_MAT3; }
+  static GLenum UniformType(glm::mat4*) { return GL_FLOAT_MAT4; }
+
   // return true if file (given in relative path) exists, false otherwise
   GLboolean FileExists(std::string const& file_name);
+
+  // read the source of shader file file_name into src, or the reason it
+  // couldn't be read into log
+  static GLboolean ReadShaderFile(std::string const& file_name, std::string& src, std::string& log);
+
+  // path of the binary cache file of a program built from sources; the
+  // name hashes the sources with the driver's vendor, renderer and version
+  // strings, since a binary is only valid for the driver that produced it
+  static std::string BinaryCachePath(std::vector<std::pair<GLenum, std::string>> const& sources);
+
+  // create the program from the binary saved at path; GL_FALSE, with no
+  // program left behind, if there is none or the driver rejects it
+  GLboolean LoadProgramBinary(std::string const& path);
+
+  // save the binary of the linked program to path
+  void SaveProgramBinary(std::string const& path) const;
+
+  // detach and delete the shader objects of the build in progress
+  void DeletePendingShaders();
+
+  // delete the files of binary_cache_dir that the current driver can't
+  // load: those saved by another driver or with another layout. It runs
+  // once, after the first program linked from sources has been saved.
+  static void PruneBinaryCache();
 };
 
 #endif /* GLSLSHADER_H */
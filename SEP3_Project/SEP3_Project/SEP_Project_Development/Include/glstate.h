@@ -0,0 +1,65 @@
+/* !
+@file		glstate.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLState, a thin tracker of
+the OpenGL binding and fixed-function state that the application changes
+while drawing.
+
+Every setter compares its argument with a shadow copy of the state and only
+calls OpenGL when the value differs, so drawing code can state what it needs
+for each draw without caring what was drawn before, and without unbinding
+afterwards. For the shadow copy to stay right, the tracked state must only be
+changed through GLState; code that changes it behind GLState's back, or
+deletes a tracked object whose name OpenGL may hand out again, must call
+invalidate() afterwards.
+
+Calls issued and elided are counted per frame; begin_frame() moves the
+counts of the frame that ended to issued_last and elided_last.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+
+/*  _________________________________________________________________________ */
+struct GLState
+  /*! GLState structure to encapsulate the render-state cache ...
+  */
+{
+  // buffer binding points tracked by bind_buffer
+  enum BufferTarget {
+    ARRAY_BUFFER,
+    DRAW_INDIRECT_BUFFER,
+    DISPATCH_INDIRECT_BUFFER,
+    BUFFER_TARGET_CNT
+  };
+
+  static void use_program(GLuint pgm_handle);
+  static void bind_vertex_array(GLuint vaoid);
+  static void bind_buffer(BufferTarget target, GLuint buffer);
+  // for GL_FRONT_AND_BACK, the only face allowed by the core profile
+  static void polygon_mode(GLenum mode);
+  static void line_width(GLfloat width);
+  static void point_size(GLfloat size);
+
+  // forget the shadow copy so that the next call of every setter is issued
+  static void invalidate();
+
+  // start counting the calls of a new frame
+  static void begin_frame();
+
+  // calls issued to and elided from the driver in the current frame, and
+  // in the last complete frame
+  static unsigned issued, elided;
+  static unsigned issued_last, elided_last;
+};
+
+#endif /* GLSTATE_H */
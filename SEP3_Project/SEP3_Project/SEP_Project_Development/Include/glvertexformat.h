@@ -0,0 +1,88 @@
+/* !
+@file		glvertexformat.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLVertexFormat, the
+descriptor of how a model's vertices are laid out in its vertex buffer. The
+model loaders fill it when they pack the vertices, and it is then used both
+to configure the model's VAO and to decode positions in the vertex shader.
+
+Vertices are interleaved. Two layouts are supported:
+
+	attribute	float layout		quantized layout
+	position	2 x float   (8 B)	2 x snorm16 (4 B) relative to the AABB
+	color		3 x float  (12 B)	4 x unorm8  (4 B) RGBA
+	normal		3 x float  (12 B)	2 x snorm16 (4 B) octahedral
+	texcoord	2 x float   (8 B)	2 x half    (4 B)
+
+The quantized attributes are decoded for free by the normalization of
+glVertexArrayAttribFormat, except for two steps done by the shader: the
+position is mapped from [-1, 1] back to the AABB with pos_decode
+(position = snorm * pos_decode.xy + pos_decode.zw), and octahedral normals
+have to be unfolded (see decode_oct). A position+color vertex shrinks from
+20 to 8 bytes; the position error is at most half a quantization step,
+that is 1/65534 of the AABB extent along each axis.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLVERTEXFORMAT_H
+#define GLVERTEXFORMAT_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+struct GLVertexFormat
+  /*! GLVertexFormat structure to describe a model's vertex layout ...
+  */
+{
+  enum Attrib { POSITION, COLOR, NORMAL, TEXCOORD, ATTRIB_CNT };
+
+  // storage of one attribute within a vertex; the attribute is absent if
+  // size is 0
+  struct Element {
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLuint offset;
+  };
+
+  std::array<Element, ATTRIB_CNT> elements;
+  GLsizei stride;
+  bool quantized;
+  // maps decoded positions to model coordinates: xy scale, zw offset
+  glm::vec4 pos_decode;
+
+  GLVertexFormat();
+
+  // Lay out vertices with positions and colors, plus normals and/or
+  // texcoords if requested, as floats or quantized.
+  static GLVertexFormat make(bool quantized, bool normals, bool texcoords);
+
+  // Interleave cnt vertices in this format. nml and uv may be null if the
+  // format has no normals or texcoords. For quantized formats pos_decode is
+  // set from the AABB of the positions.
+  std::vector<GLubyte> pack(glm::vec2 const* pos, glm::vec3 const* clr,
+                            glm::vec3 const* nml, glm::vec2 const* uv, size_t cnt);
+
+  // Source the present attributes from vbo through binding of vaoid, at
+  // their shader locations.
+  void apply(GLuint vaoid, GLuint vbo, GLuint binding) const;
+
+  // shader location of each attribute
+  static GLuint location(Attrib a);
+
+  // octahedral encoding of a unit normal into [-1, 1]^2, and its inverse
+  static glm::vec2 encode_oct(glm::vec3 n);
+  static glm::vec3 decode_oct(glm::vec2 e);
+};
+
+#endif /* GLVERTEXFORMAT_H */
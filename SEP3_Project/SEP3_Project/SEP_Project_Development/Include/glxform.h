@@ -0,0 +1,100 @@
+/* !
+@file		glxform.h
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file contains the declaration of structure GLXform that encapsulates the
+batched transform kernel used to update objects. Given contiguous arrays of
+object state, the kernel integrates every object's angular displacement and
+writes its model-to-NDC transform in a single pass.
+
+GLObjects::update used to build four full 3x3 matrices per object (scale,
+rotation, translation and world-to-NDC), call cosf/sinf twice each and
+perform three matrix multiplications. The product is really a 2x3 affine
+transform:
+
+	| kx*sx*cos  -kx*sy*sin  kx*px |
+	| ky*sx*sin   ky*sy*cos  ky*py |
+	|     0           0        1   |
+
+where (sx, sy) is the scaling, (px, py) the position and (kx, ky) the
+world-to-NDC scale. The kernel computes only these six terms, with one
+polynomial sin/cos evaluation per object, using AVX2 (8 objects), SSE2
+(4 objects) or scalar code depending on what the CPU supports.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLXFORM_H
+#define GLXFORM_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <ostream>
+
+/*  _________________________________________________________________________ */
+struct GLXform
+  /*! GLXform structure to encapsulate the batched object transform kernel ...
+  */
+{
+  // instruction set used by update() ...
+  enum class Path { SCALAR, SSE2, AVX2 };
+
+  // Maximum absolute error of sincos_deg() compared to double precision
+  // sin/cos for |deg| <= 1e5 degrees; see sincos_deg() for the derivation
+  static constexpr GLfloat SINCOS_MAX_ERROR = 2.5e-7f;
+
+  // Maximum absolute difference allowed between an element of a transform
+  // written by update() and the same element written by update_reference()
+  // for |angle_disp| <= 1e5 degrees and WORLD_WIDTH/WORLD_HEIGHT sized worlds
+  static constexpr GLfloat TOLERANCE = 1e-5f;
+
+  // For each of the count objects, integrate angle_disp by
+  // angle_speed * delta_time (both in degrees) and write the model-to-NDC
+  // transform built from the updated angle, scaling and position into
+  // mdl_to_ndc_xform. Object i's transform is written to
+  // mdl_to_ndc_xform[xform_index[i]], or to mdl_to_ndc_xform[i] if
+  // xform_index is null; this lets the kernel scatter transforms straight
+  // into their instance slots in a GPU buffer. Objects whose index is SKIP
+  // (culled ones) are integrated but their transform isn't written.
+  // World coordinates map to NDC as world_to_ndc * p + ndc_offset; without
+  // a camera world_to_ndc is (1 / (WORLD_WIDTH / 2), 1 / (WORLD_HEIGHT / 2))
+  // and ndc_offset is 0.
+  static constexpr GLuint SKIP = ~0u;
+  static void update(size_t count, GLfloat* angle_disp, GLfloat const* angle_speed,
+                     glm::vec2 const* position, glm::vec2 const* scaling,
+                     glm::mat3* mdl_to_ndc_xform, GLuint const* xform_index,
+                     GLfloat delta_time, glm::vec2 world_to_ndc,
+                     glm::vec2 ndc_offset = glm::vec2(0.0f));
+
+  // Same contract as update() without xform_index and ndc_offset, but implemented with
+  // full glm matrices and cosf/sinf, exactly as objects were updated before
+  // the kernel existed. Used as the reference that update() is verified
+  // against.
+  static void update_reference(size_t count, GLfloat* angle_disp, GLfloat const* angle_speed,
+                               glm::vec2 const* position, glm::vec2 const* scaling,
+                               glm::mat3* mdl_to_ndc_xform,
+                               GLfloat delta_time, glm::vec2 world_to_ndc);
+
+  // polynomial approximation of sin and cos of an angle given in degrees
+  static void sincos_deg(GLfloat deg, GLfloat& s, GLfloat& c);
+
+  // Instruction set used by update(). It is detected once, by the first
+  // call from any thread, and can be overridden by the main thread while no
+  // job uses it (for example to compare paths); requests for a path the CPU
+  // doesn't support fall back to the best supported one.
+  static Path path();
+  static void set_path(Path p);
+  static char const* path_name(Path p);
+
+  // Compare update_reference() and every supported path of update() at 1k,
+  // 32k and 1M objects, verify that the results agree within TOLERANCE and
+  // print the timings. Returns false if any path exceeds the tolerance.
+  static bool benchmark(std::ostream& os);
+};
+
+#endif /* GLXFORM_H */
@@ -16,14 +16,24 @@ to OpenGL implementations.
 #include <glapp.h>									//OpenGL libraries and addons
 #include <glslshader.h>								//OpenGL libraries and addons
 #include <glhelper.h>								//OpenGL libraries and addons
+#include <glxform.h>								// batched object transform kernel
+#include <glprofiler.h>								// CPU and GPU stage timing
+#include <glhud.h>									// stats overlay
+#include <glmesh.h>									// cached OBJ meshes
+#include <glshaderwatch.h>							// shader hot reload
+#include <glstate.h>								// render-state cache
+#include <glgpucull.h>								// GPU culling and indirect draws
+#include <glgpusim.h>								// GPU simulation backend
+#include <glrandom.h>								// counter-based generator
 #include <glm/gtc/type_ptr.hpp>
 
 #include <iostream>									// std::cout
 #include <array>									// std::array
 #include <string>									// std::string 
-#include <iomanip>									// precision
-#include <sstream>									// stringstream
-#include <random>
+#include <cstdio>									// std::snprintf
+#include <algorithm>								// std::min
+#include <cstdint>									// std::uint32_t
+#include <map>										// std::map
 
 
 /*                                                   objects with file scope
@@ -35,14 +45,76 @@ std::string str;									// String to put to the title.
 
 std::vector<GLSLShader> GLApp::shdrpgms{};			// Declaration of Vector Container of GLSL Shader
 std::vector<GLApp::GLModel> GLApp::models{};			// Declaration of Vector Container of GLApp::GLModel
-std::list<GLApp::GLObject> GLApp::objects{};			// Declaration of List GLApp::GLObject
+GLApp::GLObjects GLApp::objects{};					// Declaration of SoA store GLApp::GLObjects
+GLJobs::Fence GLApp::update_fence{};				// Declaration of fence of the object update jobs
+GLApp::GLStreamBuffer GLApp::instance_stream{};	// Declaration of per-instance transform stream
+GLRenderQueue GLApp::render_queue{};				// Declaration of per-frame draw packets
+GLCamera GLApp::camera{};							// Declaration of world-to-view camera
+GLGrid GLApp::grid{};								// Declaration of spatial index of objects
+GLuint GLApp::visible_cnt{};						// Declaration of objects in view
+GLuint GLApp::culled_cnt{};							// Declaration of objects out of view
+GLuint GLApp::draw_cnt{};							// Declaration of draw calls of the last frame
+std::string GLApp::mesh_path{};						// Declaration of optional mesh model path
+bool GLApp::quantize_vertices{ true };				// Declaration of vertex quantization flag
+bool GLApp::hot_reload{};							// Declaration of shader hot reload flag
+size_t GLApp::max_objects{ MAX_OBJECTS };			// Declaration of object budget
+
+// Shader files given to GLApp::init_shdrpgms_cont, and the index in
+// GLApp::shdrpgms of each of their variants compiled so far, keyed by the
+// files' index and the permutation
+std::vector<GLShaderWatch::Files> shdrpgm_sources;
+std::map<std::pair<size_t, GLSLShader::Permutation>, GLuint> shdrpgm_variants;
+
+// Files, defines and permutation of each program in GLApp::shdrpgms, and
+// its handle to the vertex shader's decode of quantized positions
+std::vector<GLShaderWatch::Program> shdrpgm_files;
+std::vector<GLSLShader::Permutation> shdrpgm_keys;
+// programs whose builds were submitted but not finished
+std::vector<GLuint> shdrpgm_pending;
+std::vector<GLSLShader::Uniform<glm::vec4>> pos_decode_uniforms;
+
+// New version of program reload_index whose link was started by
+// GLApp::reload_shdrpgms in the previous frame if reload_pending is set
+GLSLShader reload_pgm;
+size_t reload_index;
+bool reload_pending;
+
+// look up the uniform handles of program i of GLApp::shdrpgms, again
+// whenever it is reloaded since its uniforms may have moved
+void resolve_uniforms(size_t i)
+{
+	pos_decode_uniforms.resize(GLApp::shdrpgms.size());
+	if (shdrpgm_keys[i] & GLSLShader::QUANTIZED_POS)
+	{
+		pos_decode_uniforms[i] = GLApp::shdrpgms[i].GetUniform<glm::vec4>("uPosDecode");
+	}
+}
+
+// permutation of the shader program that draws the objects of mdl
+GLSLShader::Permutation mdl_permutation(GLApp::GLModel const& mdl)
+{
+	return GLSLShader::INSTANCED | (mdl.format.quantized ? GLSLShader::QUANTIZED_POS : 0u);
+}
 
-//creating random seed and generator
-std::random_device rd;// get random seed
-std::default_random_engine random(rd());// Standard mersenne_twister_engine seeded with rd()
+// radius of the smallest circle centred at the origin that holds the vertices
+GLfloat bounding_radius(std::vector<glm::vec2> const& pos_vtx)
+{
+	GLfloat radius = 0.0f;
+	for (glm::vec2 const& p : pos_vtx)
+	{
+		radius = std::max(radius, glm::length(p));
+	}
+	return radius;
+}
 
+// Streams of GLRandom drawn from: object N draws number N of the stream of
+// each scalar attribute and numbers 2N and 2N + 1 of that of each vec2
+enum RandomStream : std::uint64_t {
+	MODEL_STREAM, POSITION_STREAM, ANGLE_STREAM, ANGLE_SPEED_STREAM, SCALING_STREAM,
+	BOX_COLOR_STREAM
+};
 
-// Flag to check if the size() of the object container is max, according to MAX_OBJECTS
+// Flag to check if the size() of the object container is max, according to GLApp::max_objects
 bool _isCapacityMax;
 
 // Enumerator for Models (Rasterization)
@@ -52,41 +124,6 @@ enum polygonMode {
 }pol_mode;
 
 
-/*  _________________________________________________________________________*/
-/*! float rand_uniform_float(float min, float max)
-
-@brief
-	This fucntion is used to get the random uniform float number.
-
-@param min
-		minimum value
-
-@param max
-		maximum value
-
-@return uniform_real_distribution<float>
-		a random float value that is between the min and max value.
-*/
-float rand_uniform_float(float min, float max)
-{
-	std::uniform_real_distribution<float> rand_float_value(min, std::nextafter(max, std::numeric_limits<float>::max()));
-	return rand_float_value(random);
-}
-
-float rand_float(float min = 0.0f, float max = 1.0f)
-{
-	return min + ((max - min) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX)));
-}
-
-
-int rand_int(int min, int max)
-{
-	std::uniform_int_distribution<int> rand_int_value(min, static_cast<int>(std::nextafter(max, std::numeric_limits<float>::max())));
-	return rand_int_value(random);
-}
-
-
-
 /*  _________________________________________________________________________*/
 /*! GLApp::init()
 @brief
@@ -105,18 +142,61 @@ void GLApp::init() {
 	GLint w = GLHelper::width, h = GLHelper::height;
 	glViewport(0, 0, w, h);
 
-	// Part 3: create as many shared shader programs as required
-	// handles to shader programs must be contained in GLApp::shdrpgms
+	// Part 3: register the shader files; the programs are compiled by the
+	// models that use them, as the permutation they need, and kept in
+	// GLApp::shdrpgms
 	GLApp::VPSS shdr_file_names{ // vertex & fragment shader files
 		std::make_pair<std::string, std::string>
 		("../shaders/my-tutorial-3.vert", "../shaders/my-tutorial-3.frag")
 	};
 
 	GLApp::init_shdrpgms_cont(shdr_file_names);
+	// Submit the permutation the models will request (see mdl_permutation)
+	// now, so that the driver compiles it while the models load
+	GLApp::shdrpgm_variant(0, GLSLShader::INSTANCED |
+		(GLApp::quantize_vertices ? GLSLShader::QUANTIZED_POS : 0u));
+
+	// Part 4: allocate the object store and the per-instance transform
+	// buffer that the models' VAOs source their instanced attributes from
+	GLApp::objects.reserve(GLApp::max_objects);
+	GLApp::render_queue.reserve(GLApp::max_objects);
+	GLApp::init_instance_buffer();
+
+	// the whole world is in view until the camera moves, and the grid
+	// covers it
+	glm::vec2 const world_size{ WORLD_WIDTH, WORLD_HEIGHT };
+	GLApp::camera.reset(world_size);
+	GLApp::grid.init(-0.5f * world_size, 0.5f * world_size, GLApp::GRID_CELLS, GLApp::GRID_CELLS, GLApp::max_objects);
+
+	// the models' VAOs source their instances from GPU culling's buffer
+	// when it is enabled. GPU simulation needs it, and can be switched to
+	// whenever it is enabled
+	if (GLGpuSim::enabled)
+	{
+		GLGpuCull::enabled = true;
+	}
+	if (GLGpuCull::enabled)
+	{
+		GLGpuCull::init(GLApp::max_objects);
+		GLGpuSim::init(GLApp::max_objects);
+	}
 
-	// Part 4: initialize as many geometric models as required
+	// Part 5: initialize as many geometric models as required
 	// these geometric models must be contained in GLApp::models
 	GLApp::init_models_cont();
+	GLApp::finish_shdrpgms();
+	GLGpuCull::init_models();
+
+	// Part 6: create the timer queries of the stage profiler and the stats
+	// overlay that shows them
+	GLProfiler::init();
+	GLHud::init();
+
+	// Part 7: watch the files of every program compiled above
+	if (GLApp::hot_reload)
+	{
+		GLShaderWatch::start(shdrpgm_files);
+	}
 
 	pol_mode = polygonMode::MODE1;
 	_isCapacityMax = false;
@@ -124,70 +204,60 @@ void GLApp::init() {
 
 
 /*  _________________________________________________________________________*/
-/*! GLApp::GLObject::init()
+/*! GLApp::GLObjects::init(size_t begin, size_t end, ObjectHandle first)
 
 @brief
-	This function is called to initialize values for objects created with GLObject
-	struct.
+	This function is called to initialize values for the objects stored in
+	slots [begin, end) of the GLObjects store. Every attribute is drawn for
+	the whole range at once, straight into its array, from its own stream
+	of GLRandom at the objects' handles, so an object's initial state
+	depends on the seed and its handle only, whichever job sets it up.
+
+@param begin
+	first slot to initialize
+
+@param end
+	one past the last slot to initialize
+
+@param first
+	handle of the object in slot begin; the others follow it
 
 @return none
 
 */
-void GLApp::GLObject::init() {
+void GLApp::GLObjects::init(size_t begin, size_t end, ObjectHandle first) {
 
-	GLObject::mdl_ref = rand_int(0, 1);
-	GLObject::shd_ref = 0;
+	size_t const count = end - begin;
 
-	GLObject::position = glm::vec2{ rand_uniform_float(-1.f,1.f) * static_cast<float>(WORLD_WIDTH / 2), // x axis
-									rand_uniform_float(-1.f,1.f) * static_cast<float>(WORLD_HEIGHT / 2) // y axis
-	};
+	// model in [0, models), from the high bits of a draw
+	std::uint64_t const mdl_key = GLRandom::key(MODEL_STREAM);
+	std::uint64_t const mdl_cnt = GLApp::models.size();
+	for (size_t i = begin; i < end; i++)
+	{
+		std::uint64_t const high = GLRandom::bits(mdl_key, first + (i - begin)) >> 32;
+		mdl_ref[i] = static_cast<GLuint>((high * mdl_cnt) >> 32);
+		shd_ref[i] = 0;
+		// the instance of the model-to-NDC transform is assigned by the next
+		// update
+		instance_idx[i] = 0;
+	}
 
-	//std::cout << "pos x : " << position.x << ", " << "pos y : " << position.y << '\n';
+	// anywhere in the world
+	glm::vec2 const half_world{ WORLD_WIDTH / 2, WORLD_HEIGHT / 2 };
+	GLRandom::uniform_floats(POSITION_STREAM, 2 * first, &position[begin].x, 2 * count, -1.0f, 1.0f);
+	for (size_t i = begin; i < end; i++)
+	{
+		position[i] *= half_world;
+	}
 
 	// initialize initial angular displacement and angular speed of object
 	GLfloat const max_rotation_speed = 30.f;
-
-	//current rotation
-	GLObject::angle_disp = rand_float() * 360.f; //in degree
-
-	//rotation speed
-	GLObject::angle_speed = rand_float() * max_rotation_speed; //in degree
+	GLRandom::uniform_floats(ANGLE_STREAM, first, &angle_disp[begin], count, 0.0f, 360.f);	//in degree
+	GLRandom::uniform_floats(ANGLE_SPEED_STREAM, first, &angle_speed[begin], count, 0.0f, max_rotation_speed);	//in degree
 
 	GLfloat const min_scale = 450.f;
 	GLfloat const max_scale = 450.f;
-
-	GLObject::scaling = glm::vec2{ rand_float(min_scale,max_scale), rand_uniform_float(min_scale,max_scale) };
-
-	glm::mat3 Translate = glm::mat3
-	{
-		1, 0, position.x,
-		0, 1, position.y,
-		0, 0, 1
-	};
-
-	glm::mat3 Rotation = glm::mat3
-	{
-		cosf(glm::radians(angle_disp)), -sinf(glm::radians(angle_disp)), 0,
-		sinf(glm::radians(angle_disp)), cosf(glm::radians(angle_disp)), 0,
-		0, 0, 1
-	};
-
-	glm::mat3 Scale = glm::mat3
-	{
-		scaling.x, 0, 0,
-		0, scaling.y, 0,
-		0, 0, 1
-	};
-
-	glm::mat3 ScaleToWorldToNDC = glm::mat3
-	{
-		1 / (WORLD_WIDTH / 2), 0, 0,
-		0, 1 / (WORLD_WIDTH / 2), 0,
-		0, 0, 1
-	};
-
-	//scaling not required to transpose. They be the same after transpose
-	mdl_to_ndc_xform = ScaleToWorldToNDC * glm::transpose(Translate) * glm::transpose(Rotation) * Scale;
+	GLRandom::uniform_floats(SCALING_STREAM, 2 * first, &scaling[begin].x, 2 * count, min_scale, max_scale);
 }
 
 
@@ -201,6 +271,17 @@ void GLApp::GLObject::init() {
 */
 void GLApp::update() {
 
+	// Part 0: A new frame starts with its update. The previous frame's
+	// update jobs must be done before objects are spawned or killed
+	GLProfiler::begin_frame();
+	GLState::begin_frame();
+	GLProfiler::Scope const scope("update", false);
+	GLJobs::wait(GLApp::update_fence);
+	if (GLApp::hot_reload)
+	{
+		GLApp::reload_shdrpgms();
+	}
+
 	// Part 1: Update polygon rasterization mode ...
 	// Check if key 'P' is pressed
 	// If pressed, update polygon rasterization mode
@@ -227,6 +308,16 @@ void GLApp::update() {
 		GLHelper::keystateP = GL_FALSE;
 	}
 
+	// Check if key 'G' is pressed
+	// If pressed, switch between the CPU and GPU simulation backends
+	// (see GLGpuSim); only possible with GPU culling
+	if (GLHelper::keystateG == GL_TRUE)
+	{
+		GLGpuSim::select(!GLGpuSim::enabled);
+		std::cout << (GLGpuSim::enabled ? "GPU" : "CPU") << " simulation\n";
+		GLHelper::keystateG = GL_FALSE;
+	}
+
 
 
 	// Part 2: Spawn or kill objects ...
@@ -238,27 +329,18 @@ void GLApp::update() {
 		// Set LMouseState (GLHelper) to GL_FALSE
 		GLHelper::LMouseState = GL_FALSE;
 
-		// Check 1: Checks if object size is lesser than or equals to MAX_OBJECTS as set by the user (32768)
+		// Check 1: Checks if object size is lesser than or equals to the object budget (GLApp::max_objects)
 		// Check 2: Checks if _isCapacityMax is TRUE or FALSE
-		if (GLApp::objects.size() <= MAX_OBJECTS && _isCapacityMax == false)
+		if (GLApp::objects.size() <= GLApp::max_objects && _isCapacityMax == false)
 		{
 
 			// Spawn new object(s)
-			// Multiply the number of objects by 2
+			// Multiply the number of objects by 2, up to the budget
 			size_t currentObjectCount = GLApp::objects.size();
-			size_t newObjectCount = currentObjectCount * 2;
-
-			// Spawn new objects
-			for (size_t i = currentObjectCount; i < newObjectCount; i++)
-			{
-				GLApp::GLObject newObject{};
-
+			size_t newObjectCount = std::min(currentObjectCount * 2, GLApp::max_objects);
 
-				newObject.init();
-				GLApp::models[newObject.mdl_ref].model_cnt++;
-				// ...
-				GLApp::objects.emplace_back(newObject);
-			}
+			// Spawn new objects, all at once
+			GLApp::objects.spawn(newObjectCount - currentObjectCount);
 
 
 			// Initial Number of Objects to spawn on first click.
@@ -271,21 +353,11 @@ void GLApp::update() {
 			if (GLApp::objects.size() == 0)
 			{
 				size_t numNewObjects = 1;
-				for (size_t i = 0; i < numNewObjects; i++)
-				{
-
-					GLApp::GLObject newObject{};
-
-					newObject.init();
-
-					GLApp::models[newObject.mdl_ref].model_cnt++;
-					// ...
-					GLApp::objects.emplace_back(newObject);
-				}
+				GLApp::objects.spawn(numNewObjects);
 			}
 
-			// Check: Checks if object size is equals to the MAX_OBJECTS
-			if (GLApp::objects.size() >= MAX_OBJECTS)
+			// Check: Checks if object size is equals to the object budget
+			if (GLApp::objects.size() >= GLApp::max_objects)
 			{
 				_isCapacityMax = true;
 			}
@@ -296,16 +368,8 @@ void GLApp::update() {
 			// Kill oldest objects
 			size_t numObjectsToKill = GLApp::objects.size() / 2;  // Number of objects to kill
 
-			for (size_t i = 0; i < numObjectsToKill; i++)
-			{
-				// if the container is not empty
-				if (!GLApp::objects.empty())
-				{
-					// model count decrement
-					GLApp::models[GLApp::objects.front().mdl_ref].model_cnt--;
-					GLApp::objects.pop_front();  // Remove the oldest object from the front of the list
-				}
-			}
+			// Remove the oldest objects from the head of the ring
+			GLApp::objects.kill_oldest(numObjectsToKill);
 
 			// Flag to check if the size is 1
 			if (GLApp::objects.size() == 1)
@@ -327,8 +391,42 @@ void GLApp::update() {
 	// A more elaborate implementation would animate the object's movement
 	// A much more elaborate implementation would animate the object's size
 	// Using updated attributes, compute world-to-ndc transformation matrix
-	for (GLApp::GLObject& obj : GLApp::objects)
-		obj.update(GLHelper::delta_time);
+	// The transforms are written straight into this frame's region of the
+	// instance stream, at the instance the render queue assigned to each
+	// object in view of the camera
+	// With GPU culling, the state of every object is written to the region
+	// instead and the GPU culls and transforms the objects (see GLGpuCull).
+	// With GPU simulation, the region isn't written at all: only spawned
+	// objects are uploaded and the GPU integrates the angles (see GLGpuSim)
+	GLApp::camera.update(GLHelper::delta_time);
+	if (GLGpuCull::enabled)
+	{
+		GLGpuCull::Object* states = static_cast<GLGpuCull::Object*>(GLApp::instance_stream.begin_region());
+		if (GLGpuSim::enabled)
+		{
+			GLGpuSim::update(GLHelper::delta_time);
+			return;
+		}
+		size_t const oldest = GLApp::objects.slot(GLApp::objects.head);
+		GLApp::objects.for_each_range([states, oldest](size_t begin, size_t end) {
+			GLJobs::parallel_for(begin, end, GLApp::UPDATE_GRAIN, [states, oldest](size_t b, size_t e) {
+				GLApp::objects.update_states(b, e, GLHelper::delta_time, oldest, states);
+			}, GLApp::update_fence);
+		});
+		return;
+	}
+
+	GLApp::queue_objects();
+	glm::mat3* instances = static_cast<glm::mat3*>(GLApp::instance_stream.begin_region());
+
+	// The objects are split into chunks of UPDATE_GRAIN that are updated in
+	// parallel by the job system; GLApp::draw waits on update_fence before
+	// rendering from the region
+	GLApp::objects.for_each_range([instances](size_t begin, size_t end) {
+		GLJobs::parallel_for(begin, end, GLApp::UPDATE_GRAIN, [instances](size_t b, size_t e) {
+			GLApp::objects.update(b, e, GLHelper::delta_time, instances);
+		}, GLApp::update_fence);
+	});
 
 }
 
@@ -344,131 +442,438 @@ void GLApp::draw()
 
 
 	// Set polygon mode based on the mode selector above.
+	// GLState only reaches the driver when the mode actually changes
 	switch (pol_mode)
 	{
 	case polygonMode::MODE1:
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		GLState::polygon_mode(GL_FILL);
 		break;
 	case polygonMode::MODE2:
-		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		glLineWidth(2.0f);
+		GLState::polygon_mode(GL_LINE);
+		GLState::line_width(2.0f);
 		break;
 	case polygonMode::MODE3:
-		glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
-		glPointSize(5.0f);
+		GLState::polygon_mode(GL_POINT);
+		GLState::point_size(5.0f);
 		break;
 	}
 
 
 	// Part 2: Clear back buffer
-	glClear(GL_COLOR_BUFFER_BIT);
+	{
+		GLProfiler::Scope const scope("clear");
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	// Part 4: Render every object in container GLApp::objects with one
+	// instanced draw call per run of objects sharing their draw state
+	{
+		GLProfiler::Scope const scope("models");
+		GLApp::draw_instanced();
+	}
+
+	// Part 5: Render the stats overlay
+	// The text is only reformatted every GLHud::refresh_interval seconds,
+	// into a fixed buffer so that no memory is allocated
+	{
+		GLProfiler::Scope const scope("hud");
+		if (GLHud::due())
+		{
+			char text[GLHud::MAX_TEXT];
+			size_t const size = sizeof(text);
+			int n = std::snprintf(text, size,
+				"%s | Angus Tan Yit Hoe\n"
+				"Obj: %zu  Box: %u  Draws: %u  Sim: %s\n"
+				"Visible: %u  Culled: %u  Zoom: %.2f\n"
+				"FPS: %.2f  GPU: %.2f ms  Stalls: %u\n"
+				"GL state calls: %u issued  %u elided\n",
+				GLHelper::title.c_str(), GLApp::objects.size(), GLApp::models[0].model_cnt, GLApp::draw_cnt,
+				GLGpuSim::enabled ? "GPU" : "CPU",
+				GLApp::visible_cnt, GLApp::culled_cnt, GLApp::camera.zoom,
+				GLHelper::fps, GLProfiler::gpu_frame_ms(), GLApp::instance_stream.stall_cnt,
+				GLState::issued_last, GLState::elided_last);
+			for (size_t i = 0; i < GLProfiler::stage_count() && n > 0 && static_cast<size_t>(n) < size; i++)
+			{
+				n += std::snprintf(text + n, size - n, "%-8s cpu %7.3f ms  gpu %7.3f ms\n",
+					GLProfiler::stage_name(i), GLProfiler::cpu_ms(i), GLProfiler::gpu_ms(i));
+			}
+			GLHud::set_text(text);
+		}
+		GLHud::draw();
+	}
+}
 
-	// Part 4: Render each object in container GLApp::objects
-	for (auto const& x : GLApp::objects) {
-		x.draw(); // call member function GLObject::draw()
+/*  _________________________________________________________________________*/
+/*! GLApp::queue_objects()
+
+@brief
+	This function fills GLApp::render_queue with one packet per object in
+	view of GLApp::camera, keyed by the shader program and model it is
+	drawn with, sorts it and assigns every object the instance its
+	transform is written to: the position of its packet in the sorted
+	queue. The objects of a run therefore occupy consecutive instances.
+	Objects out of view are found through GLApp::grid without being
+	visited; their instance is GLXform::SKIP, so their transforms aren't
+	written.
+	The objects have no material. The draw order of the 2D objects is
+	their spawn order, which the grid doesn't keep, so their depth is their
+	age: the number of objects spawned before them that are still alive.
+
+@return none
+
+*/
+void GLApp::queue_objects()
+{
+	// Part 1: Nothing is drawn unless it is in view
+	GLApp::objects.for_each_range([](size_t begin, size_t end) {
+		std::vector<GLuint>& idx = GLApp::objects.instance_idx;
+		std::fill(idx.begin() + begin, idx.begin() + end, GLuint(GLXform::SKIP));
+	});
+
+	// Part 2: One packet per object in view
+	GLRenderQueue& queue = GLApp::render_queue;
+	queue.clear();
+	size_t const oldest = GLApp::objects.slot(GLApp::objects.head);
+	size_t const capacity = GLApp::objects.capacity();
+	GLApp::grid.query(GLApp::camera.view_min(), GLApp::camera.view_max(), [&queue, oldest, capacity](GLuint i) {
+		GLuint const mdl = GLApp::objects.mdl_ref[i];
+		GLuint const age = static_cast<GLuint>((i + capacity - oldest) % capacity);
+		queue.push(GLRenderQueue::make_key(GLApp::models[mdl].shdrpgm, mdl, 0, age), i);
+	});
+
+	// Part 3: Sort by state and hand out the instances in sorted order
+	queue.sort();
+	for (size_t i = 0; i < queue.packets.size(); i++)
+	{
+		GLApp::objects.instance_idx[queue.packets[i].object] = static_cast<GLuint>(i);
 	}
 
-	// Part 1: Write window title
-	std::stringstream sStream;
-	sStream << GLHelper::title << " | Angus Tan Yit Hoe"
-		<< " | Obj: " << GLApp::objects.size()
-		<< " | Box: " << GLApp::models[1].model_cnt
-		<< " | Mystery: " << GLApp::models[0].model_cnt
-		<< " | FPS: " << std::fixed << std::setprecision(2) << GLHelper::fps;
-	std::string windowTitle = sStream.str();
-	glfwSetWindowTitle(GLHelper::ptr_window, windowTitle.c_str());
+	GLApp::visible_cnt = static_cast<GLuint>(queue.packets.size());
+	GLApp::culled_cnt = static_cast<GLuint>(GLApp::objects.size()) - GLApp::visible_cnt;
 }
 
 /*  _________________________________________________________________________*/
-/*! GLApp::GLObject::draw() const
+/*! GLApp::draw_instanced()
 
 @brief
-	This function draw the object into the viewport
+	This function renders every object in GLApp::objects using one instanced
+	draw call per run of GLApp::render_queue.
+	GLApp::update has written each object's model-to-NDC transform into the
+	current region of GLApp::instance_stream, at the instance of its packet
+	in the sorted queue. Each run is drawn with
+	glDrawElementsInstancedBaseInstance, whose base instance selects the
+	run's range within the region. Runs are in key order, so the program
+	changes at most once per program in use and the VAO at most once per
+	model, and the number of draw calls per frame equals the number of
+	distinct states, not the number of objects.
+	Finally the region is fenced so the CPU won't overwrite it before the
+	GPU has read it.
 
 @return none
 
 */
-void GLApp::GLObject::draw() const
+void GLApp::draw_instanced()
 {
-	// Part 1: Install the shader program
-	GLApp::shdrpgms[shd_ref].Use(); // Install the shader program
+	// Part 1: The transforms must be written
+	GLJobs::wait(GLApp::update_fence);
+	GLApp::draw_cnt = 0;
+
+	// Part 2: Render each run with one instanced draw call
+	if (GLGpuCull::enabled)
+	{
+		GLApp::draw_gpu_culled();
+	}
+	else if (!GLApp::render_queue.runs.empty())
+	{
+		GLuint const region_first = static_cast<GLuint>(
+			GLApp::instance_stream.region_offset() / sizeof(glm::mat3));
+
+		// programs and VAOs are left bound; GLState skips rebinding them
+		for (GLRenderQueue::Run const& run : GLApp::render_queue.runs)
+		{
+			GLuint const pgm = GLRenderQueue::shader(run.key);
+			GLApp::GLModel const& mdl = GLApp::models[GLRenderQueue::model(run.key)];
+
+			GLApp::shdrpgms[pgm].Use();
+			GLApp::shdrpgms[pgm].SetUniform(pos_decode_uniforms[pgm], mdl.format.pos_decode);
+			GLState::bind_vertex_array(mdl.vaoid);
+			glDrawElementsInstancedBaseInstance(
+				mdl.primitive_type,
+				mdl.draw_cnt,
+				mdl.index_type, NULL,
+				run.count,
+				region_first + run.first);
+			GLApp::draw_cnt++;
+		}
+	}
+
+	// Part 3: Release the region to the GPU
+	GLApp::instance_stream.end_region();
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::draw_gpu_culled()
 
-	// Part 2: Bind object's VAO handle
-	glBindVertexArray(GLApp::models[mdl_ref].vaoid); // Bind object's VAO handle
+@brief
+	This function culls the objects whose states GLApp::update wrote to the
+	current region of GLApp::instance_stream, or that GLGpuSim keeps in the
+	slots of GLApp::objects, on the GPU, then draws the
+	visible objects of each model with one glMultiDrawElementsIndirect
+	whose command the GPU wrote. The CPU work is the same whatever the
+	number of objects. The visible count reported is a few frames old
+	(see GLGpuCull::visible_cnt).
+
+@return none
 
-	// Part 3: Copy object's 3x3 model-to-NDC matrix to vertex shader
-	GLint uniform_var_loc1 = glGetUniformLocation(GLApp::shdrpgms[shd_ref].GetHandle(), "uModel_to_NDC");
-	if (uniform_var_loc1 >= 0) {
-		glUniformMatrix3fv(uniform_var_loc1, 1, GL_FALSE, glm::value_ptr(GLApp::GLObject::mdl_to_ndc_xform));
+*/
+void GLApp::draw_gpu_culled()
+{
+	GLuint const count = static_cast<GLuint>(GLApp::objects.size());
+	if (GLGpuSim::enabled)
+	{
+		GLGpuCull::dispatch(GLGpuSim::object_buffer(), 0, count,
+			static_cast<GLuint>(GLApp::objects.slot(GLApp::objects.head)),
+			static_cast<GLuint>(GLApp::objects.capacity()));
 	}
-	else {
-		std::cout << "Uniform variable doesn't exist!!!" << std::endl;
-		std::exit(EXIT_FAILURE);
+	else
+	{
+		GLGpuCull::dispatch(GLApp::instance_stream.bufid, GLApp::instance_stream.region_offset(),
+			count, 0, count);
 	}
 
-	// Part 4: Render using glDrawElements or glDrawArrays
-	glDrawElements(
-		models[mdl_ref].primitive_type,
-		models[mdl_ref].draw_cnt,
-		GL_UNSIGNED_SHORT, NULL);
+	GLState::bind_buffer(GLState::DRAW_INDIRECT_BUFFER, GLGpuCull::command_buffer());
+	for (size_t m = 0; m < GLApp::models.size() && m < GLGpuCull::MAX_MODELS; m++)
+	{
+		GLApp::GLModel const& mdl = GLApp::models[m];
+		if (mdl.model_cnt == 0)
+		{
+			continue;
+		}
+
+		GLApp::shdrpgms[mdl.shdrpgm].Use();
+		GLApp::shdrpgms[mdl.shdrpgm].SetUniform(pos_decode_uniforms[mdl.shdrpgm], mdl.format.pos_decode);
+		GLState::bind_vertex_array(mdl.vaoid);
+		glMultiDrawElementsIndirect(mdl.primitive_type, mdl.index_type,
+			reinterpret_cast<void const*>(sizeof(GLGpuCull::DrawCommand) * m), 1, 0);
+		GLApp::draw_cnt++;
+	}
 
-	// Part 5: Clean up
-	glBindVertexArray(0); // Unbind the VAO
-	GLApp::shdrpgms[shd_ref].UnUse(); // Uninstall the shader program
+	GLApp::visible_cnt = std::min(GLGpuCull::visible_cnt, static_cast<GLuint>(GLApp::objects.size()));
+	GLApp::culled_cnt = static_cast<GLuint>(GLApp::objects.size()) - GLApp::visible_cnt;
 }
 
 /*  _________________________________________________________________________*/
-/*! GLApp::GLObject::update(GLdouble deltaTime)
+/*! GLApp::GLObjects::update(size_t begin, size_t end, GLdouble deltaTime, glm::mat3* instances)
 
 @brief
-	This function updates the GLObject object's physics (Scale, Rotation,
-	Translation)
+	This function updates the physics (Scale, Rotation, Translation) of the
+	objects stored in slots [begin, end) of the GLObjects store.
+
+@param begin
+		first slot to update
+
+@param end
+		one past the last slot to update
 
 @param deltaTime
 		the time per frame for each loop.
 
+@param instances
+		transforms of the current region of the instance stream; the
+		transform of the object in slot i is written to
+		instances[instance_idx[i]]
+
+@return none
+
+*/
+void GLApp::GLObjects::update(size_t begin, size_t end, GLdouble deltaTime, glm::mat3* instances)
+{
+	// Integrate the angular displacements and compute the model-to-world-to-NDC
+	// transformation matrices of the whole range in one batched pass; the
+	// camera doesn't move while the update jobs run
+	GLXform::update(end - begin, &angle_disp[begin], &angle_speed[begin],
+		&position[begin], &scaling[begin], instances, &instance_idx[begin],
+		static_cast<GLfloat>(deltaTime), GLApp::camera.world_to_ndc(), GLApp::camera.ndc_offset());
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::GLObjects::update_states(size_t begin, size_t end, GLdouble deltaTime, size_t oldest, GLGpuCull::Object* states)
+
+@brief
+	This function integrates the angular displacements of the objects
+	stored in slots [begin, end), which must not wrap around the ring, and
+	writes their state for GPU culling in spawn order: the object in slot i
+	goes to states[age], age being the number of live objects spawned
+	before it.
+
+@param oldest
+	slot of the oldest live object
+
+@param states
+	states of the current region of the instance stream
+
+@return none
+
+*/
+void GLApp::GLObjects::update_states(size_t begin, size_t end, GLdouble deltaTime, size_t oldest, GLGpuCull::Object* states)
+{
+	GLfloat const dt = static_cast<GLfloat>(deltaTime);
+	size_t const cap = capacity();
+	GLGpuCull::Object* out = states + (begin + cap - oldest) % cap;
+	for (size_t i = begin; i < end; i++, out++)
+	{
+		angle_disp[i] += angle_speed[i] * dt;
+		*out = state(i);
+	}
+}
+
+GLGpuCull::Object GLApp::GLObjects::state(size_t i) const
+{
+	return GLGpuCull::Object{ position[i], scaling[i], angle_disp[i], mdl_ref[i], bound_radius(i), angle_speed[i] };
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::GLObjects::reserve(size_t capacity)
+
+@brief
+	This function allocates every array of the store for the given number
+	of objects. The arrays are never resized afterwards so slots, and with
+	them handles, stay stable for the lifetime of an object.
+
+@param capacity
+	maximum number of live objects
+
 @return none
 
 */
-void GLApp::GLObject::update(GLdouble deltaTime)
+void GLApp::GLObjects::reserve(size_t capacity)
+{
+	scaling.resize(capacity);
+	angle_speed.resize(capacity);
+	angle_disp.resize(capacity);
+	position.resize(capacity);
+	instance_idx.resize(capacity);
+	mdl_ref.resize(capacity);
+	shd_ref.resize(capacity);
+	head = tail = 0;
+}
+
+size_t GLApp::GLObjects::capacity() const
+{
+	return angle_disp.size();
+}
+
+size_t GLApp::GLObjects::size() const
+{
+	return static_cast<size_t>(tail - head);
+}
+
+bool GLApp::GLObjects::empty() const
+{
+	return head == tail;
+}
+
+GLfloat GLApp::GLObjects::bound_radius(size_t i) const
+{
+	return GLApp::models[mdl_ref[i]].radius * std::max(std::abs(scaling[i].x), std::abs(scaling[i].y));
+}
+
+bool GLApp::GLObjects::alive(GLApp::ObjectHandle hdl) const
+{
+	return hdl >= head && hdl < tail;
+}
+
+size_t GLApp::GLObjects::slot(GLApp::ObjectHandle hdl) const
+{
+	return static_cast<size_t>(hdl % capacity());
+}
+
+GLApp::ObjectHandle GLApp::GLObjects::spawn()
 {
-	GLObject::angle_disp += (GLObject::angle_speed * static_cast<float>(deltaTime));
+	return spawn(1);
+}
 
-	// Compute the angular displacement in radians
+/*  _________________________________________________________________________*/
+/*! GLApp::GLObjects::spawn(size_t count)
+
+@brief
+	This function appends count new objects at the tail of the ring. Their
+	random initial states are set in parallel, UPDATE_GRAIN objects per
+	job, each object drawing from GLRandom at its handle; then
+	they are accounted for in their models' counts and, if the objects are
+	culled on the CPU, inserted in the grid.
+	The store must have room for them.
 
+@param count
+	number of objects to spawn
 
-	// Compute the scale matrix
-	glm::mat3 Scale = glm::mat3(
-		scaling.x, 0.0f, 0.0f,
-		0.0f, scaling.y, 0.0f,
-		0.0f, 0.0f, 1.0f
-	);
+@return ObjectHandle
+	handle of the first new object
 
-	// Compute the rotation matrix
-	glm::mat3 Rotation = glm::mat3(
-		cosf(glm::radians(GLObject::angle_disp)), -sinf(glm::radians(GLObject::angle_disp)), 0.0f,
-		sinf(glm::radians(GLObject::angle_disp)), cosf(glm::radians(GLObject::angle_disp)), 0.0f,
-		0.0f, 0.0f, 1.0f
-	);
+*/
+GLApp::ObjectHandle GLApp::GLObjects::spawn(size_t count)
+{
+	ObjectHandle const first = tail;
+	tail += count;
+
+	// Part 1: Initial states, per contiguous range of slots
+	GLJobs::Fence fence;
+	ObjectHandle range_first = first;
+	for_each_slot_range(first, tail, [this, &range_first, &fence](size_t begin, size_t end) {
+		ObjectHandle const hdl = range_first;
+		GLJobs::parallel_for(begin, end, GLApp::UPDATE_GRAIN, [this, begin, hdl](size_t b, size_t e) {
+			init(b, e, hdl + (b - begin));
+		}, fence);
+		range_first += end - begin;
+	});
+	GLJobs::wait(fence);
+
+	// Part 2: Model counts and spatial index
+	for_each_slot_range(first, tail, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			GLApp::models[mdl_ref[i]].model_cnt++;
+		}
+		if (!GLGpuCull::enabled)
+		{
+			GLApp::grid.insert(static_cast<GLuint>(begin), static_cast<GLuint>(end),
+				[this](GLuint i, glm::vec2& center, GLfloat& radius) {
+					center = position[i];
+					radius = bound_radius(i);
+				});
+		}
+	});
+	return first;
+}
 
-	// Compute the translation matrix
-	glm::mat3 Translation = glm::mat3(
-		1.0f, 0.0f, position.x,
-		0.0f, 1.0f, position.y,
-		0.0f, 0.0f, 1.0f
-	);
+/*  _________________________________________________________________________*/
+/*! GLApp::GLObjects::kill_oldest(size_t count)
 
+@brief
+	This function kills the count oldest objects by advancing the head of the
+	ring. No memory is released or moved; only the model counts of the killed
+	objects and, if the objects are culled on the CPU, the grid are updated.
 
-	// Compute the scaling matrix to map from world coordinates to NDC coordinates
-	glm::mat3 ScaleToWorldToNDC = glm::mat3(
-		1.0f / (WORLD_WIDTH / 2), 0.0f, 0.0f,
-		0.0f, 1.0f / (WORLD_HEIGHT / 2), 0.0f,
-		0.0f, 0.0f, 1.0f
-	);
+@param count
+	number of objects to kill, clamped to the number of live objects
 
+@return none
 
-	// Compute the model-to-world-to-NDC transformation matrix
-	mdl_to_ndc_xform = ScaleToWorldToNDC * glm::transpose(Translation) * glm::transpose(Rotation) * glm::transpose(Scale);
+*/
+void GLApp::GLObjects::kill_oldest(size_t count)
+{
+	count = std::min(count, size());
+	for_each_slot_range(head, head + count, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			GLApp::models[mdl_ref[i]].model_cnt--;
+		}
+		if (!GLGpuCull::enabled)
+		{
+			GLApp::grid.remove(static_cast<GLuint>(begin), static_cast<GLuint>(end));
+		}
+	});
+	head += count;
 }
 
 /*  _________________________________________________________________________*/
@@ -478,11 +883,19 @@ void GLApp::GLObject::update(GLdouble deltaTime)
 
 
 @return none
-Empty for now
 
 */
 void GLApp::cleanup() {
-	// empty for now
+	GLShaderWatch::stop();
+	GLJobs::wait(GLApp::update_fence);
+	GLApp::instance_stream.destroy();
+	if (GLGpuCull::enabled)
+	{
+		GLGpuSim::cleanup();
+		GLGpuCull::cleanup();
+	}
+	GLProfiler::cleanup();
+	GLHud::cleanup();
 }
 
 /*  _________________________________________________________________________*/
@@ -513,57 +926,35 @@ GLApp::GLModel GLApp::box_model()
 			glm::vec2(-0.5f, 0.5f), glm::vec2(-0.5f, -0.5f)
 	};
 
-	std::default_random_engine dre(std::random_device{}());
-	std::uniform_real_distribution<float> urdf(0.f, std::nextafter(1.f, std::numeric_limits<float>::max()));
-	std::vector<glm::vec3> clr_vtx;
-
-	for (size_t i{}; i < pos_vtx.size(); i++)
-	{
-		float red = urdf(dre);
-		float blue = urdf(dre);
-		float green = urdf(dre);
-
-		glm::vec3 color_to_push = { red, green, blue };
-		clr_vtx.push_back(color_to_push);
-	}
+	// random vertex colors, the same for every run with the same seed
+	std::vector<glm::vec3> clr_vtx(pos_vtx.size());
+	GLRandom::uniform_floats(BOX_COLOR_STREAM, 0, &clr_vtx[0].x, 3 * clr_vtx.size(), 0.0f, 1.0f);
 
 	GLApp::GLModel mdl;
+	// Interleave the vertex position and color attributes in the layout
+	// selected by GLApp::quantize_vertices
+	mdl.format = GLVertexFormat::make(GLApp::quantize_vertices, false, false);
+	std::vector<GLubyte> const vtx = mdl.format.pack(pos_vtx.data(), clr_vtx.data(),
+		nullptr, nullptr, pos_vtx.size());
+
 	// Allocating buffer objects
-	// transfer vertex position and colowr attributes to VBO
+	// transfer vertex attributes to VBO
 	GLuint vbo_hdl;
 	glCreateBuffers(1, &vbo_hdl);
 
 	//Allocating and filling data store
-	glNamedBufferStorage(vbo_hdl,
-		sizeof(glm::vec2) * pos_vtx.size() + sizeof(glm::vec3) * clr_vtx.size(),
-		nullptr, GL_DYNAMIC_STORAGE_BIT);
-	//transfer vertex position data
-	glNamedBufferSubData(vbo_hdl, 0,
-		sizeof(glm::vec2) * pos_vtx.size(), pos_vtx.data());
-	//transfer vertex color data
-	glNamedBufferSubData(vbo_hdl, sizeof(glm::vec2) * pos_vtx.size(),
-		sizeof(glm::vec3) * clr_vtx.size(), clr_vtx.data());
+	glNamedBufferStorage(vbo_hdl, vtx.size(), vtx.data(), 0);
 
 	GLuint vaoid;
 	// encapsulate information about contents of VBO and VBO handlee
 	// to another object called VAO
 	glCreateVertexArrays(1, &vaoid); // vaoid is data member of GLApp::GLModel
 
-	// for vertex position array, we use vertex attribute index 8
-	// and vertex buffer binding point 3
-	glEnableVertexArrayAttrib(vaoid, 0);
-	glVertexArrayVertexBuffer(vaoid, 3, vbo_hdl, 0, sizeof(glm::vec2));
-	glVertexArrayAttribFormat(vaoid, 0, 2, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(vaoid, 0, 3);
-
-	// Color Attributes
-	// for vertex color array, we use vertex attribute index 9
-	// and vertex buffer binding point 4
-	glEnableVertexArrayAttrib(vaoid, 1);
-	glVertexArrayVertexBuffer(vaoid, 4, vbo_hdl,
-		sizeof(glm::vec2) * pos_vtx.size(), sizeof(glm::vec3));
-	glVertexArrayAttribFormat(vaoid, 1, 3, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(vaoid, 1, 4);
+	// the vertex attributes are sourced from vertex buffer binding point 3
+	mdl.format.apply(vaoid, vbo_hdl, 3);
+
+	// Per-instance model-to-NDC transform
+	GLApp::bind_instance_attribs(vaoid);
 
 	// represents indices of vertices that will define 2 triangles with
 	// counterclockwise winding
@@ -588,16 +979,94 @@ GLApp::GLModel GLApp::box_model()
 	//attached the element buffer object to the vertex array object
 	//and unbind the vertex array object
 	glVertexArrayElementBuffer(vaoid, ebo_hdl);
-	glBindVertexArray(0);
 
 	mdl.vaoid = vaoid;
+	mdl.shdrpgm = GLApp::shdrpgm_variant(0, mdl_permutation(mdl));
 	mdl.primitive_type = GL_TRIANGLES;
 	mdl.draw_cnt = idx_vtx.size();
 	mdl.primitive_cnt = pos_vtx.size();
+	mdl.radius = bounding_radius(pos_vtx);
 	return mdl;
 }
 
 
+/*  _________________________________________________________________________*/
+/*! GLApp::GLModel GLApp::mesh_model(GLMesh const& mesh)
+
+@brief
+	This function creates a model from a mesh. The mesh is projected onto
+	the xy plane and scaled so that its bounding box fits in the unit box
+	centred at the origin, like the box model. Each vertex is colored by its
+	normal, or grey if the mesh has no normals.
+
+@param mesh
+	loaded mesh; its arrays are only read while the buffers are filled
+
+@return Model mdl
+	Returns the model
+
+*/
+GLApp::GLModel GLApp::mesh_model(GLMesh const& mesh)
+{
+	// Part 1: positions and colors
+	glm::vec2 lo(mesh.positions[0]), hi(mesh.positions[0]);
+	for (glm::vec3 const& p : mesh.positions)
+	{
+		lo = glm::min(lo, glm::vec2(p));
+		hi = glm::max(hi, glm::vec2(p));
+	}
+	glm::vec2 const centre = (lo + hi) * 0.5f;
+	GLfloat const extent = std::max(hi.x - lo.x, hi.y - lo.y);
+	GLfloat const scale = (extent > 0.0f) ? 1.0f / extent : 1.0f;
+
+	std::vector<glm::vec2> pos_vtx;
+	std::vector<glm::vec3> clr_vtx;
+	pos_vtx.reserve(mesh.positions.size());
+	clr_vtx.reserve(mesh.positions.size());
+	for (size_t i = 0; i < mesh.positions.size(); i++)
+	{
+		pos_vtx.push_back((glm::vec2(mesh.positions[i]) - centre) * scale);
+		clr_vtx.push_back(mesh.normals.empty() ? glm::vec3(0.5f) : mesh.normals[i] * 0.5f + 0.5f);
+	}
+
+	// Part 2: VBO with the interleaved vertices, laid out and bound like the
+	// box model's. The normals already color the vertices, so only
+	// positions and colors are uploaded.
+	GLApp::GLModel mdl;
+	mdl.format = GLVertexFormat::make(GLApp::quantize_vertices, false, false);
+	std::vector<GLubyte> const vtx = mdl.format.pack(pos_vtx.data(), clr_vtx.data(),
+		nullptr, nullptr, pos_vtx.size());
+
+	GLuint vbo_hdl;
+	glCreateBuffers(1, &vbo_hdl);
+	glNamedBufferStorage(vbo_hdl, vtx.size(), vtx.data(), 0);
+
+	GLuint vaoid;
+	glCreateVertexArrays(1, &vaoid);
+	mdl.format.apply(vaoid, vbo_hdl, 3);
+
+	GLApp::bind_instance_attribs(vaoid);
+
+	// Part 3: the triangles are uploaded straight from the mapped cache,
+	// with 16-bit indices unless the mesh has too many vertices for them
+	GLuint ebo_hdl;
+	glCreateBuffers(1, &ebo_hdl);
+	glNamedBufferStorage(ebo_hdl,
+		mesh.index_size() * mesh.index_cnt(),
+		mesh.index_data(),
+		GL_DYNAMIC_STORAGE_BIT);
+	glVertexArrayElementBuffer(vaoid, ebo_hdl);
+
+	mdl.vaoid = vaoid;
+	mdl.shdrpgm = GLApp::shdrpgm_variant(0, mdl_permutation(mdl));
+	mdl.primitive_type = GL_TRIANGLES;
+	mdl.draw_cnt = static_cast<GLuint>(mesh.index_cnt());
+	mdl.index_type = mesh.index_type;
+	mdl.primitive_cnt = static_cast<GLuint>(mesh.positions.size());
+	mdl.radius = bounding_radius(pos_vtx);
+	return mdl;
+}
+
 /*  _________________________________________________________________________*/
 /*! GLApp::init_models_cont()
 
@@ -609,6 +1078,180 @@ GLApp::GLModel GLApp::box_model()
 */
 void GLApp::init_models_cont() {
 	GLApp::models.emplace_back(GLApp::box_model());
+
+	// the mesh is only needed until its model's buffers are filled
+	if (!GLApp::mesh_path.empty())
+	{
+		GLMesh mesh;
+		if (mesh.load(GLApp::mesh_path))
+		{
+			GLApp::models.emplace_back(GLApp::mesh_model(mesh));
+			std::cout << "Loaded mesh " << GLApp::mesh_path
+				<< (mesh.parsed ? " (parsed)" : " (cached)") << ", "
+				<< GLApp::models.back().format.stride << " bytes per vertex\n";
+		}
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::init_instance_buffer()
+
+@brief
+	This function allocates the stream that holds one model-to-NDC transform
+	per object in each of its INSTANCE_REGIONS regions. Regions are sized
+	for the object budget so that the stream never has to be reallocated
+	while objects are spawned.
+
+@return none
+
+*/
+void GLApp::init_instance_buffer() {
+	// the regions also hold the objects' states for GPU culling
+	static_assert(sizeof(GLGpuCull::Object) <= sizeof(glm::mat3), "object state doesn't fit in a region");
+	GLApp::instance_stream.init(sizeof(glm::mat3) * GLApp::max_objects, GLApp::INSTANCE_REGIONS);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::GLStreamBuffer::init(GLsizeiptr size, GLuint count)
+
+@brief
+	This function allocates immutable storage for count regions of size
+	bytes and maps all of it persistently and coherently, so writes through
+	the mapping become visible to the GPU without explicit flushes.
+	The size is rounded up to a multiple of 256 bytes, the largest offset
+	alignment OpenGL allows for buffer ranges, so that every region can
+	be bound as a shader storage buffer.
+
+@param size
+	size in bytes of one region
+
+@param count
+	number of regions
+
+@return none
+
+*/
+void GLApp::GLStreamBuffer::init(GLsizeiptr size, GLuint count) {
+	GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	region_size = (size + 255) / 256 * 256;
+	region_cnt = count;
+	region = 0;
+	stall_cnt = 0;
+	fences.assign(count, nullptr);
+
+	glCreateBuffers(1, &bufid);
+	glNamedBufferStorage(bufid, region_size * region_cnt, nullptr, flags);
+	mapped = static_cast<GLubyte*>(glMapNamedBufferRange(bufid, 0, region_size * region_cnt, flags));
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::GLStreamBuffer::begin_region()
+
+@brief
+	This function waits until the GPU has finished the commands that last
+	read the current region. The fence is polled first; only if it hasn't
+	signalled yet is the wait counted as a stall and the wait repeated with
+	a flush until it does.
+
+@return void*
+	mapped address of the current region
+
+*/
+void* GLApp::GLStreamBuffer::begin_region() {
+	GLsync& fence = fences[region];
+	if (fence)
+	{
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			stall_cnt++;
+			do
+			{
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+	return mapped + region_offset();
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::GLStreamBuffer::end_region()
+
+@brief
+	This function places a fence after the commands that read the current
+	region and moves on to the next region.
+
+@return none
+
+*/
+void GLApp::GLStreamBuffer::end_region() {
+	fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	region = (region + 1) % region_cnt;
+}
+
+GLintptr GLApp::GLStreamBuffer::region_offset() const {
+	return static_cast<GLintptr>(region_size) * region;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::GLStreamBuffer::destroy()
+
+@brief
+	This function releases the fences, the mapping and the buffer.
+
+@return none
+
+*/
+void GLApp::GLStreamBuffer::destroy() {
+	for (GLsync& fence : fences)
+	{
+		if (fence)
+		{
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	if (bufid)
+	{
+		glUnmapNamedBuffer(bufid);
+		glDeleteBuffers(1, &bufid);
+		bufid = 0;
+	}
+	mapped = nullptr;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::bind_instance_attribs(GLuint vaoid)
+
+@brief
+	This function sources the per-instance model-to-NDC transform of the
+	given VAO from GLApp::instance_stream.
+	A mat3 vertex attribute occupies three consecutive attribute indices,
+	one per column, so attribute indices 2, 3 and 4 are used. They are fed
+	from vertex buffer binding point 5 with a divisor of 1 so that the
+	transform advances once per instance instead of once per vertex.
+
+@param vaoid
+	handle of the VAO to configure
+
+@return none
+
+*/
+void GLApp::bind_instance_attribs(GLuint vaoid) {
+	GLuint const buffer = GLGpuCull::enabled ? GLGpuCull::instance_buffer() : GLApp::instance_stream.bufid;
+	glVertexArrayVertexBuffer(vaoid, 5, buffer, 0, sizeof(glm::mat3));
+	glVertexArrayBindingDivisor(vaoid, 5, 1);
+
+	for (GLuint col = 0; col < 3; col++)
+	{
+		glEnableVertexArrayAttrib(vaoid, 2 + col);
+		glVertexArrayAttribFormat(vaoid, 2 + col, 3, GL_FLOAT, GL_FALSE,
+			static_cast<GLuint>(sizeof(glm::vec3) * col));
+		glVertexArrayAttribBinding(vaoid, 2 + col, 5);
+	}
 }
 
 /*  _________________________________________________________________________*/
@@ -628,10 +1271,160 @@ void GLApp::init_shdrpgms_cont(GLApp::VPSS const& vpss) {
 		std::vector<std::pair<GLenum, std::string>> shdr_files;
 		shdr_files.emplace_back(std::make_pair(GL_VERTEX_SHADER, x.first));
 		shdr_files.emplace_back(std::make_pair(GL_FRAGMENT_SHADER, x.second));
-		GLSLShader shdr_pgm;
-		shdr_pgm.CompileLinkValidate(shdr_files);
-		// insert shader program into container
-		GLApp::shdrpgms.emplace_back(shdr_pgm);
+		shdrpgm_sources.push_back(shdr_files);
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::shdrpgm_variant(size_t source, GLSLShader::Permutation key)
+
+@brief
+	This function returns the program built from the shader files
+	registered at index source by init_shdrpgms_cont, with the names
+	selected by key #define'd. Each variant is compiled the first time it
+	is requested and appended to GLApp::shdrpgms; later requests return the
+	same program.
+
+@param source
+	index of the shader files in the GLApp::VPSS given to init_shdrpgms_cont
+
+@param key
+	permutation bits (see GLSLShader::PermutationDefines)
+
+@return GLuint
+	index of the program in GLApp::shdrpgms
+*/
+GLuint GLApp::shdrpgm_variant(size_t source, GLSLShader::Permutation key)
+{
+	auto const found = shdrpgm_variants.find(std::make_pair(source, key));
+	if (found != shdrpgm_variants.end())
+	{
+		return found->second;
+	}
+
+	GLShaderWatch::Program files{ shdrpgm_sources[source], GLSLShader::PermutationDefines(key), {} };
+	for (auto const& f : files.files)
+	{
+		std::vector<std::string> const included = GLSLShader::IncludedFiles(f.second);
+		files.includes.insert(files.includes.end(), included.begin(), included.end());
+	}
+
+	// the build is only submitted; finish_shdrpgms waits for it
+	GLSLShader shdr_pgm;
+	std::vector<std::pair<GLenum, std::string>> sources;
+	std::string log;
+	if (GL_FALSE == GLSLShader::ReadSources(files.files, files.defines, sources, log) ||
+		GL_FALSE == shdr_pgm.StartBuild(sources))
+	{
+		std::cout << "Unable to compile/link/validate shader programs\n"
+			<< log << shdr_pgm.GetLog() << '\n';
+	}
+	// insert shader program into container
+	GLuint const index = static_cast<GLuint>(GLApp::shdrpgms.size());
+	GLApp::shdrpgms.emplace_back(shdr_pgm);
+	shdrpgm_files.push_back(files);
+	shdrpgm_keys.push_back(key);
+	shdrpgm_pending.push_back(index);
+	shdrpgm_variants.emplace(std::make_pair(source, key), index);
+	return index;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::finish_shdrpgms()
+
+@brief
+	This function waits for the programs submitted by shdrpgm_variant since
+	the last call, all together (see GLSLShader::FinishBuilds), and looks up
+	their uniforms. A program that failed is reported and draws nothing.
+
+@return none
+*/
+void GLApp::finish_shdrpgms()
+{
+	std::vector<GLSLShader*> batch;
+	for (GLuint index : shdrpgm_pending)
+	{
+		batch.push_back(&GLApp::shdrpgms[index]);
+	}
+	GLSLShader::FinishBuilds(batch);
+
+	for (GLuint index : shdrpgm_pending)
+	{
+		if (GL_FALSE == GLApp::shdrpgms[index].IsLinked())
+		{
+			std::cout << "Unable to compile/link/validate shader programs\n"
+				<< GLApp::shdrpgms[index].GetLog() << '\n';
+		}
+		resolve_uniforms(index);
+	}
+	shdrpgm_pending.clear();
+}
+
+/*  _________________________________________________________________________*/
+/*! GLApp::reload_shdrpgms()
+
+@brief
+	This function replaces shader programs whose sources have changed. The
+	sources were already read by the watcher thread. A new program's
+	compilation and link are submitted in one frame and their result is
+	queried at the start of a later one: once the driver reports the build
+	complete if it compiles in parallel (see GLSLShader::IsBuildComplete),
+	otherwise in the next frame, by which time it has usually finished, so
+	the frame doesn't wait for the compiler. The new
+	program replaces the old one only if it linked; otherwise the old one
+	stays in use and the compiler's messages are printed.
+
+@return none
+*/
+void GLApp::reload_shdrpgms()
+{
+	// Part 1: Swap in the program submitted in the previous frame
+	if (reload_pending)
+	{
+		if (GL_FALSE == reload_pgm.IsBuildComplete())
+		{
+			return;
+		}
+		reload_pending = false;
+		if (GL_TRUE == reload_pgm.FinishBuild())
+		{
+			GLApp::shdrpgms[reload_index].DeleteShaderProgram();
+			GLApp::shdrpgms[reload_index] = reload_pgm;
+			resolve_uniforms(reload_index);
+			std::cout << "Reloaded shader program " << reload_index << '\n';
+		}
+		else
+		{
+			std::cout << "Shader program " << reload_index << " not reloaded: "
+				<< reload_pgm.GetLog() << '\n';
+			reload_pgm.DeleteShaderProgram();
+		}
+		return;
+	}
+
+	// Part 2: Submit the next changed program
+	GLShaderWatch::Update update;
+	if (!GLShaderWatch::pop(update) || update.program >= GLApp::shdrpgms.size())
+	{
+		return;
+	}
+	shdrpgm_files[update.program].includes = update.includes;
+	if (!update.ok)
+	{
+		std::cout << "Shader program " << update.program << " not reloaded: " << update.log << '\n';
+		return;
+	}
+	reload_pgm = GLSLShader();
+	reload_index = update.program;
+	if (GL_TRUE == reload_pgm.StartBuild(update.sources))
+	{
+		reload_pending = true;
+	}
+	else
+	{
+		std::cout << "Shader program " << update.program << " not reloaded: "
+			<< reload_pgm.GetLog() << '\n';
+		reload_pgm.DeleteShaderProgram();
 	}
 }
 
@@ -0,0 +1,340 @@
+/*!
+@file		glbench.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the benchmark suite declared in glbench.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glbench.h>
+#include <glapp.h>
+#include <glhelper.h>
+#include <gljobs.h>
+#include <glprofiler.h>
+#include <glrandom.h>
+
+#include <algorithm>								// std::sort
+#include <chrono>									// std::chrono::steady_clock
+#include <cstdint>									// std::uint64_t
+#include <fstream>									// std::ofstream
+#include <iterator>									// std::next
+#include <iomanip>									// std::setprecision
+#include <iostream>									// std::cout
+#include <map>										// std::map
+#include <vector>									// std::vector
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	enum Scenario { RAMP, STEADY, KILL_HALF, SIM_CPU, SIM_GPU };
+	char const* const scenario_names[] = { "ramp", "steady", "kill_half", "sim_cpu", "sim_gpu" };
+
+	// measurements of one frame
+	struct FrameSample {
+		Scenario scenario;
+		size_t objects;
+		double update_ms;
+		double draw_ms;
+		double gpu_ms;
+		bool gpu_valid;
+	};
+
+	// p50/p95/p99 of one measurement over a group of frames
+	struct Percentiles {
+		double p50, p95, p99;
+	};
+
+	// frames of one scenario at one object count
+	struct Group {
+		std::vector<double> update_ms, draw_ms, gpu_ms;
+	};
+
+	std::vector<FrameSample> samples;
+
+	// sample of each profiler frame whose GPU time hasn't been reported yet
+	std::map<std::uint64_t, size_t> frame_samples;
+
+	/*  _________________________________________________________________________*/
+	/*! gpu_frame
+
+	@brief
+		GLProfiler::frame_listener of the bench: records the GPU time of a
+		profiler frame, all its stages, in the frame's sample. Frames whose
+		results GLProfiler dropped are never reported and keep no GPU time.
+
+	@return none
+	*/
+	void gpu_frame(std::uint64_t frame, double gpu_ms)
+	{
+		auto const found = frame_samples.find(frame);
+		if (found != frame_samples.end())
+		{
+			samples[found->second].gpu_ms = gpu_ms;
+			samples[found->second].gpu_valid = true;
+			frame_samples.erase(frame_samples.begin(), std::next(found));
+		}
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! frame
+
+	@brief
+		This function runs and measures one iteration of the game loop. With
+		click set, the left mouse button is reported as pressed, exactly as
+		GLHelper::mousebutton_cb would.
+
+	@return none
+	*/
+	void frame(Scenario scenario, bool click)
+	{
+		using clock = std::chrono::steady_clock;
+
+		GLHelper::update_time(1.0);
+		if (click)
+		{
+			GLHelper::LMouseState = GL_TRUE;
+		}
+
+		clock::time_point const t0 = clock::now();
+		GLApp::update();
+		clock::time_point const t1 = clock::now();
+
+		// GLApp::update began the profiler frame that times this frame
+		samples.push_back(FrameSample{ scenario, GLApp::objects.size(), 0.0, 0.0, 0.0, false });
+		frame_samples[GLProfiler::frame_number()] = samples.size() - 1;
+		GLApp::draw();
+		clock::time_point const t2 = clock::now();
+
+		samples.back().update_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+		samples.back().draw_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! percentiles
+
+	@brief
+		This function computes the nearest-rank p50, p95 and p99 of values.
+
+	@return Percentiles
+	*/
+	Percentiles percentiles(std::vector<double> values)
+	{
+		if (values.empty())
+		{
+			return Percentiles{ 0.0, 0.0, 0.0 };
+		}
+		std::sort(values.begin(), values.end());
+		auto const rank = [&values](double p) {
+			size_t const r = static_cast<size_t>(p * static_cast<double>(values.size()) + 0.999999);
+			return values[std::min(values.size(), std::max<size_t>(r, 1)) - 1];
+		};
+		return Percentiles{ rank(0.50), rank(0.95), rank(0.99) };
+	}
+
+	// escape a string for use inside a JSON string literal
+	std::string json_escape(std::string const& s)
+	{
+		std::string out;
+		for (char c : s)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out += '\\';
+			}
+			out += c;
+		}
+		return out;
+	}
+
+	using Groups = std::map<std::pair<Scenario, size_t>, Group>;
+
+	/*  _________________________________________________________________________*/
+	/*! write_csv
+
+	@brief
+		This function writes one line per scenario and object count.
+
+	@return none
+	*/
+	void write_csv(std::ostream& os, GLBench::Options const& opt, Groups const& groups)
+	{
+		os << "label,scenario,objects,frames";
+		for (char const* m : { "update", "draw", "gpu" })
+		{
+			os << ',' << m << "_p50_ms," << m << "_p95_ms," << m << "_p99_ms";
+		}
+		os << '\n' << std::fixed << std::setprecision(4);
+
+		for (auto const& g : groups)
+		{
+			os << opt.label << ',' << scenario_names[g.first.first] << ','
+				<< g.first.second << ',' << g.second.update_ms.size();
+			for (std::vector<double> const* v : { &g.second.update_ms, &g.second.draw_ms, &g.second.gpu_ms })
+			{
+				Percentiles const p = percentiles(*v);
+				os << ',' << p.p50 << ',' << p.p95 << ',' << p.p99;
+			}
+			os << '\n';
+		}
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! write_json
+
+	@brief
+		This function writes the run's context and one result per scenario
+		and object count.
+
+	@return none
+	*/
+	void write_json(std::ostream& os, GLBench::Options const& opt, Groups const& groups)
+	{
+		char const* const renderer = reinterpret_cast<char const*>(glGetString(GL_RENDERER));
+
+		os << std::fixed << std::setprecision(4)
+			<< "{\n"
+			<< "  \"label\": \"" << json_escape(opt.label) << "\",\n"
+			<< "  \"renderer\": \"" << json_escape(renderer ? renderer : "") << "\",\n"
+			<< "  \"threads\": " << GLJobs::thread_count() << ",\n"
+			<< "  \"seed\": " << GLRandom::seed << ",\n"
+			<< "  \"results\": [";
+
+		char const* sep = "\n";
+		for (auto const& g : groups)
+		{
+			os << sep << "    { \"scenario\": \"" << scenario_names[g.first.first]
+				<< "\", \"objects\": " << g.first.second
+				<< ", \"frames\": " << g.second.update_ms.size();
+
+			char const* const names[] = { "update_ms", "draw_ms", "gpu_ms" };
+			std::vector<double> const* const values[] = { &g.second.update_ms, &g.second.draw_ms, &g.second.gpu_ms };
+			for (size_t m = 0; m < 3; m++)
+			{
+				Percentiles const p = percentiles(*values[m]);
+				os << ", \"" << names[m] << "\": { \"p50\": " << p.p50
+					<< ", \"p95\": " << p.p95 << ", \"p99\": " << p.p99 << " }";
+			}
+			os << " }";
+			sep = ",\n";
+		}
+		os << "\n  ]\n}\n";
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLBench::run(Options const& opt)
+
+@brief
+	This function replays opt.repeat cycles of the scenarios. Each cycle
+	clicks until GLApp::update has doubled the objects up to the object
+	budget
+	(ramp), recording opt.steady_frames frames without clicks at each count
+	(steady), and then clicks until it has halved them back to 1
+	(kill_half). Every click is followed by opt.settle_frames frames that
+	are recorded under the click's scenario. With opt.compare_sim, the
+	steady frames at each count are followed by as many frames on the CPU
+	simulation backend (sim_cpu) and on the GPU one (sim_gpu), after which
+	the backend in use before is selected again. Finally the frames are
+	grouped by scenario and object count and the percentiles are reported.
+
+@param opt
+	scenario lengths and report destinations
+
+@return bool
+	false if a report file couldn't be written
+
+*/
+bool GLBench::run(Options const& opt)
+{
+	// Part 1: Replay the scenarios
+	samples.clear();
+	frame_samples.clear();
+	GLProfiler::frame_listener = gpu_frame;
+	bool const compare_sim = opt.compare_sim && GLGpuSim::available();
+	bool const gpu_sim = GLGpuSim::enabled;
+	if (opt.compare_sim && !compare_sim)
+	{
+		std::cerr << "GPU simulation unavailable; sim_cpu and sim_gpu are skipped" << std::endl;
+	}
+
+	for (unsigned cycle = 0; cycle < opt.repeat; cycle++)
+	{
+		while (GLApp::objects.size() < GLApp::max_objects)
+		{
+			frame(RAMP, true);
+			for (unsigned f = 0; f < opt.settle_frames; f++)
+			{
+				frame(RAMP, false);
+			}
+			for (unsigned f = 0; f < opt.steady_frames; f++)
+			{
+				frame(STEADY, false);
+			}
+			if (compare_sim)
+			{
+				for (Scenario sim : { SIM_CPU, SIM_GPU })
+				{
+					GLGpuSim::select(sim == SIM_GPU);
+					for (unsigned f = 0; f < opt.steady_frames; f++)
+					{
+						frame(sim, false);
+					}
+				}
+				GLGpuSim::select(gpu_sim);
+			}
+		}
+
+		while (GLApp::objects.size() > 1)
+		{
+			frame(KILL_HALF, true);
+			for (unsigned f = 0; f < opt.settle_frames; f++)
+			{
+				frame(KILL_HALF, false);
+			}
+		}
+	}
+
+	GLProfiler::flush();
+	GLProfiler::frame_listener = nullptr;
+
+	// Part 2: Group the frames by scenario and object count
+	Groups groups;
+	for (FrameSample const& s : samples)
+	{
+		Group& g = groups[std::make_pair(s.scenario, s.objects)];
+		g.update_ms.push_back(s.update_ms);
+		g.draw_ms.push_back(s.draw_ms);
+		if (s.gpu_valid)
+		{
+			g.gpu_ms.push_back(s.gpu_ms);
+		}
+	}
+
+	// Part 3: Write the reports
+	bool ok = true;
+	if (!opt.csv_path.empty())
+	{
+		std::ofstream ofs(opt.csv_path);
+		write_csv(ofs, opt, groups);
+		ok = ok && static_cast<bool>(ofs);
+	}
+	if (!opt.json_path.empty())
+	{
+		std::ofstream ofs(opt.json_path);
+		write_json(ofs, opt, groups);
+		ok = ok && static_cast<bool>(ofs);
+	}
+	if (opt.csv_path.empty() && opt.json_path.empty())
+	{
+		write_csv(std::cout, opt, groups);
+	}
+	if (!ok)
+	{
+		std::cerr << "Unable to write benchmark report" << std::endl;
+	}
+	return ok;
+}
@@ -0,0 +1,102 @@
+/*!
+@file		glcamera.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the 2D camera declared in glcamera.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glcamera.h>
+#include <glhelper.h>
+
+#include <cmath>									// std::pow
+
+/*  _________________________________________________________________________*/
+/*! GLCamera::reset(glm::vec2 size)
+
+@brief
+	This function shows the whole world of the given size.
+
+@param size
+	width and height of the world
+
+@return none
+*/
+void GLCamera::reset(glm::vec2 size)
+{
+	world_size = size;
+	center = glm::vec2(0.0f);
+	zoom = 1.0f;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLCamera::update(GLdouble delta_time)
+
+@brief
+	This function pans the camera while W, A, S, D or the arrow keys are
+	held, at PAN_SPEED view widths per second whatever the zoom, and zooms
+	by ZOOM_STEP per notch of the mouse wheel. The centre is kept inside
+	the world. Without a window the camera doesn't move.
+
+@param delta_time
+	the time per frame for each loop.
+
+@return none
+*/
+void GLCamera::update(GLdouble delta_time)
+{
+	if (GLHelper::headless || !GLHelper::ptr_window)
+	{
+		return;
+	}
+
+	// Part 1: Zoom
+	if (GLHelper::scroll_offset != 0.0)
+	{
+		zoom *= static_cast<GLfloat>(std::pow(ZOOM_STEP, GLHelper::scroll_offset));
+		zoom = glm::clamp(zoom, MIN_ZOOM, MAX_ZOOM);
+		GLHelper::scroll_offset = 0.0;
+	}
+
+	// Part 2: Pan
+	auto held = [](int key, int alt) {
+		return glfwGetKey(GLHelper::ptr_window, key) == GLFW_PRESS ||
+			glfwGetKey(GLHelper::ptr_window, alt) == GLFW_PRESS;
+	};
+	glm::vec2 dir(0.0f);
+	dir.x += held(GLFW_KEY_D, GLFW_KEY_RIGHT) ? 1.0f : 0.0f;
+	dir.x -= held(GLFW_KEY_A, GLFW_KEY_LEFT) ? 1.0f : 0.0f;
+	dir.y += held(GLFW_KEY_W, GLFW_KEY_UP) ? 1.0f : 0.0f;
+	dir.y -= held(GLFW_KEY_S, GLFW_KEY_DOWN) ? 1.0f : 0.0f;
+
+	center += dir * (2.0f * half_extent() * PAN_SPEED * static_cast<GLfloat>(delta_time));
+	center = glm::clamp(center, -0.5f * world_size, 0.5f * world_size);
+}
+
+glm::vec2 GLCamera::half_extent() const
+{
+	return 0.5f * world_size / zoom;
+}
+
+glm::vec2 GLCamera::view_min() const
+{
+	return center - half_extent();
+}
+
+glm::vec2 GLCamera::view_max() const
+{
+	return center + half_extent();
+}
+
+glm::vec2 GLCamera::world_to_ndc() const
+{
+	return 1.0f / half_extent();
+}
+
+glm::vec2 GLCamera::ndc_offset() const
+{
+	return -center * world_to_ndc();
+}
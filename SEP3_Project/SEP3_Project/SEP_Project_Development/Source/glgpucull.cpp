@@ -0,0 +1,282 @@
+/*!
+@file		glgpucull.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements GPU culling and indirect draw generation declared in
+glgpucull.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glgpucull.h>
+#include <glapp.h>
+#include <glslshader.h>
+
+#include <algorithm>								// std::max, std::min
+#include <iostream>									// std::cout
+#include <string>									// std::string
+#include <utility>									// std::pair
+#include <vector>									// std::vector
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+bool GLGpuCull::enabled{};
+GLuint GLGpuCull::visible_cnt{};
+
+namespace {
+
+	// storage buffer binding points, as in shaders/cull.glsl
+	enum Binding : GLuint {
+		OBJECTS = 0,
+		GROUP_COUNTS = 1,
+		COMMANDS = 2,
+		INSTANCES = 3
+	};
+
+	constexpr GLsizeiptr COMMANDS_SIZE = sizeof(GLGpuCull::DrawCommand) * GLGpuCull::MAX_MODELS;
+
+	// programs of the three passes and their uniforms
+	GLSLShader count_pgm, scan_pgm, compact_pgm;
+	struct CullUniforms {
+		GLSLShader::Uniform<GLint> count, first, capacity;
+		GLSLShader::Uniform<glm::vec2> view_min, view_max;
+	} count_uniforms, compact_uniforms;
+	GLSLShader::Uniform<GLint> scan_groups;
+	GLSLShader::Uniform<glm::vec2> world_to_ndc, ndc_offset;
+
+	GLuint instances = 0;
+	GLuint group_counts = 0;
+	GLuint commands = 0;
+	// INSTANCE_REGIONS copies of the commands, one per region of
+	// GLApp::instance_stream, persistently mapped for reading
+	GLuint readback = 0;
+	GLGpuCull::DrawCommand const* readback_mapped = nullptr;
+
+	GLuint group_cnt(size_t objects)
+	{
+		return static_cast<GLuint>((objects + GLGpuCull::GROUP_SIZE - 1) / GLGpuCull::GROUP_SIZE);
+	}
+
+	GLboolean compile(GLSLShader& pgm, char const* file)
+	{
+		std::vector<std::pair<GLenum, std::string>> const shdr_files{
+			std::make_pair(GL_COMPUTE_SHADER, std::string(file))
+		};
+		return pgm.CompileLinkValidate(shdr_files);
+	}
+
+	CullUniforms cull_uniforms(GLSLShader& pgm)
+	{
+		CullUniforms u;
+		u.count = pgm.GetUniform<GLint>("uCount");
+		u.first = pgm.GetUniform<GLint>("uFirst");
+		u.capacity = pgm.GetUniform<GLint>("uCapacity");
+		u.view_min = pgm.GetUniform<glm::vec2>("uViewMin");
+		u.view_max = pgm.GetUniform<glm::vec2>("uViewMax");
+		return u;
+	}
+
+	void set_cull_uniforms(GLSLShader& pgm, CullUniforms const& u, GLuint count, GLuint first, GLuint capacity)
+	{
+		pgm.Use();
+		pgm.SetUniform(u.count, static_cast<GLint>(count));
+		pgm.SetUniform(u.first, static_cast<GLint>(first));
+		pgm.SetUniform(u.capacity, static_cast<GLint>(capacity));
+		pgm.SetUniform(u.view_min, GLApp::camera.view_min());
+		pgm.SetUniform(u.view_max, GLApp::camera.view_max());
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuCull::init(size_t capacity)
+
+@brief
+	This function compiles the programs of the three passes and allocates
+	the buffers they use. Only the draw commands and their read-back copies
+	are ever accessed by the CPU.
+
+@param capacity
+	maximum number of objects
+
+@return none
+*/
+void GLGpuCull::init(size_t capacity)
+{
+	// Part 1: programs
+	if (GL_FALSE == compile(count_pgm, "../shaders/cull-count.comp") ||
+		GL_FALSE == compile(scan_pgm, "../shaders/cull-scan.comp") ||
+		GL_FALSE == compile(compact_pgm, "../shaders/cull-compact.comp"))
+	{
+		std::cout << "GPU culling disabled\n";
+		GLGpuCull::enabled = false;
+		return;
+	}
+	count_uniforms = cull_uniforms(count_pgm);
+	compact_uniforms = cull_uniforms(compact_pgm);
+	scan_groups = scan_pgm.GetUniform<GLint>("uGroups");
+	world_to_ndc = compact_pgm.GetUniform<glm::vec2>("uWorldToNDC");
+	ndc_offset = compact_pgm.GetUniform<glm::vec2>("uNDCOffset");
+
+	// Part 2: buffers written and read by the GPU only
+	glCreateBuffers(1, &instances);
+	glNamedBufferStorage(instances, sizeof(glm::mat3) * capacity, nullptr, 0);
+	glCreateBuffers(1, &group_counts);
+	glNamedBufferStorage(group_counts, sizeof(GLuint) * MAX_MODELS * group_cnt(capacity), nullptr, 0);
+
+	// Part 3: draw commands, and their copies read by the CPU; zeroed so
+	// that nothing is reported visible before the first copy has landed
+	std::vector<GLubyte> const zeros(COMMANDS_SIZE * GLApp::INSTANCE_REGIONS, 0);
+	glCreateBuffers(1, &commands);
+	glNamedBufferStorage(commands, COMMANDS_SIZE, zeros.data(), GL_DYNAMIC_STORAGE_BIT);
+
+	GLbitfield const flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glCreateBuffers(1, &readback);
+	glNamedBufferStorage(readback, zeros.size(), zeros.data(), flags | GL_CLIENT_STORAGE_BIT);
+	readback_mapped = static_cast<DrawCommand const*>(
+		glMapNamedBufferRange(readback, 0, zeros.size(), flags));
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuCull::init_models()
+
+@brief
+	This function writes the fields of the draw commands that don't change
+	from frame to frame: every model draws all its indices, from the start
+	of its own index buffer.
+
+@return none
+*/
+void GLGpuCull::init_models()
+{
+	if (!GLGpuCull::enabled)
+	{
+		return;
+	}
+	if (GLApp::models.size() > MAX_MODELS)
+	{
+		std::cout << "GPU culling only draws the first " << MAX_MODELS << " models\n";
+	}
+
+	DrawCommand cmds[MAX_MODELS] = {};
+	for (size_t m = 0; m < GLApp::models.size() && m < MAX_MODELS; m++)
+	{
+		cmds[m].count = GLApp::models[m].draw_cnt;
+	}
+	glNamedBufferSubData(commands, 0, sizeof(cmds), cmds);
+}
+
+void GLGpuCull::cleanup()
+{
+	if (readback)
+	{
+		glUnmapNamedBuffer(readback);
+	}
+	GLuint const buffers[] = { instances, group_counts, commands, readback };
+	glDeleteBuffers(4, buffers);
+	instances = group_counts = commands = readback = 0;
+	readback_mapped = nullptr;
+	count_pgm.DeleteShaderProgram();
+	scan_pgm.DeleteShaderProgram();
+	compact_pgm.DeleteShaderProgram();
+}
+
+GLuint GLGpuCull::instance_buffer()
+{
+	return instances;
+}
+
+GLuint GLGpuCull::command_buffer()
+{
+	return commands;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuCull::dispatch(GLuint buffer, GLintptr offset, GLuint count, GLuint first, GLuint capacity)
+
+@brief
+	This function runs the three passes over the objects, separated by the
+	barriers that make each pass's writes visible to the next and to the
+	draws, then copies the commands for reporting. The objects must have
+	been written by the CPU through a coherent mapping, or by a compute
+	shader followed by a shader storage barrier.
+
+@param buffer
+	buffer holding the objects
+
+@param offset
+	offset in bytes of the first object in buffer; a multiple of the
+	shader storage buffer offset alignment
+
+@param count
+	number of objects
+
+@param first
+	index of the oldest object in buffer; the others follow it in spawn
+	order, wrapping around to index 0 after capacity objects
+
+@param capacity
+	number of objects buffer holds from offset; at least count
+
+@return none
+*/
+void GLGpuCull::dispatch(GLuint buffer, GLintptr offset, GLuint count, GLuint first, GLuint capacity)
+{
+	GLuint const region = GLApp::instance_stream.region;
+
+	// Part 1: The copy made in the current region's last frame is complete,
+	// since the CPU waited for that frame's fence before writing the region
+	GLGpuCull::visible_cnt = 0;
+	for (GLuint m = 0; m < MAX_MODELS; m++)
+	{
+		GLGpuCull::visible_cnt += readback_mapped[region * MAX_MODELS + m].instance_count;
+	}
+
+	// Part 2: Bind the buffers; a range can't be empty
+	GLuint const groups = group_cnt(count);
+	capacity = std::max(capacity, 1u);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, OBJECTS, buffer, offset, sizeof(Object) * capacity);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GROUP_COUNTS, group_counts);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMANDS, commands);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INSTANCES, instances);
+
+	// Part 3: Count, scan and compact
+	set_cull_uniforms(count_pgm, count_uniforms, count, first, capacity);
+	dispatch_groups(groups);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+	scan_pgm.Use();
+	scan_pgm.SetUniform(scan_groups, static_cast<GLint>(groups));
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	set_cull_uniforms(compact_pgm, compact_uniforms, count, first, capacity);
+	compact_pgm.SetUniform(world_to_ndc, GLApp::camera.world_to_ndc());
+	compact_pgm.SetUniform(ndc_offset, GLApp::camera.ndc_offset());
+	dispatch_groups(groups);
+	glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+	// Part 4: Keep the visible counts of this frame
+	glCopyNamedBufferSubData(commands, readback, 0, COMMANDS_SIZE * region, COMMANDS_SIZE);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuCull::dispatch_groups(GLuint groups)
+
+@brief
+	This function dispatches groups work groups of the program in use. A
+	single row would exceed the 65535 groups GL guarantees in x from
+	65535 * GROUP_SIZE objects on, so the groups are laid out in rows of
+	MAX_GROUPS_X; the last row is completed by groups that do nothing.
+
+@param groups
+	number of work groups
+
+@return none
+*/
+void GLGpuCull::dispatch_groups(GLuint groups)
+{
+	GLuint const x = std::min(groups, MAX_GROUPS_X);
+	glDispatchCompute(x, (groups + MAX_GROUPS_X - 1) / MAX_GROUPS_X, 1);
+}
@@ -0,0 +1,205 @@
+/*!
+@file		glgpusim.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the GPU simulation backend declared in glgpusim.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glgpusim.h>
+#include <glgpucull.h>
+#include <glapp.h>
+#include <glprofiler.h>
+#include <glslshader.h>
+
+#include <algorithm>								// std::max
+#include <iostream>									// std::cout
+#include <string>									// std::string
+#include <utility>									// std::pair
+#include <vector>									// std::vector
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+bool GLGpuSim::enabled{};
+
+namespace {
+
+	GLSLShader sim_pgm;
+	struct SimUniforms {
+		GLSLShader::Uniform<GLint> count, first, capacity;
+		GLSLShader::Uniform<GLfloat> delta_time;
+	} uniforms;
+
+	// states of every slot of GLApp::objects
+	GLuint objects = 0;
+	// objects with handles from uploaded on are yet to be uploaded
+	GLApp::ObjectHandle uploaded = 0;
+	// states on their way to or from objects
+	std::vector<GLGpuCull::Object> staging;
+
+	// objects whose states are gathered per job
+	constexpr size_t STAGING_GRAIN = 4096;
+
+	/*  _________________________________________________________________________*/
+	/*! upload(GLApp::ObjectHandle first, GLApp::ObjectHandle last)
+
+	@brief
+		This function gathers the states of the objects with handles
+		[first, last) and uploads them to their slots, with one
+		glNamedBufferSubData per contiguous range of slots.
+
+	@return none
+	*/
+	void upload(GLApp::ObjectHandle first, GLApp::ObjectHandle last)
+	{
+		GLApp::objects.for_each_slot_range(first, last, [](size_t begin, size_t end) {
+			staging.resize(end - begin);
+			GLJobs::Fence fence;
+			GLJobs::parallel_for(begin, end, STAGING_GRAIN, [begin](size_t b, size_t e) {
+				for (size_t i = b; i < e; i++)
+				{
+					staging[i - begin] = GLApp::objects.state(i);
+				}
+			}, fence);
+			GLJobs::wait(fence);
+
+			glNamedBufferSubData(objects, sizeof(GLGpuCull::Object) * begin,
+				sizeof(GLGpuCull::Object) * staging.size(), staging.data());
+		});
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuSim::init(size_t capacity)
+
+@brief
+	This function compiles the simulation's compute shader and allocates
+	the states of every slot. If the shader doesn't build, the CPU backend
+	stays in use.
+
+@param capacity
+	number of slots of GLApp::objects
+
+@return none
+*/
+void GLGpuSim::init(size_t capacity)
+{
+	std::vector<std::pair<GLenum, std::string>> const shdr_files{
+		std::make_pair(GL_COMPUTE_SHADER, std::string("../shaders/sim-update.comp"))
+	};
+	if (GL_FALSE == sim_pgm.CompileLinkValidate(shdr_files))
+	{
+		std::cout << "GPU simulation disabled\n" << sim_pgm.GetLog() << '\n';
+		GLGpuSim::enabled = false;
+		return;
+	}
+	uniforms.count = sim_pgm.GetUniform<GLint>("uCount");
+	uniforms.first = sim_pgm.GetUniform<GLint>("uFirst");
+	uniforms.capacity = sim_pgm.GetUniform<GLint>("uCapacity");
+	uniforms.delta_time = sim_pgm.GetUniform<GLfloat>("uDeltaTime");
+
+	glCreateBuffers(1, &objects);
+	glNamedBufferStorage(objects, sizeof(GLGpuCull::Object) * capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	uploaded = 0;
+}
+
+void GLGpuSim::cleanup()
+{
+	glDeleteBuffers(1, &objects);
+	objects = 0;
+	sim_pgm.DeleteShaderProgram();
+	staging.clear();
+	staging.shrink_to_fit();
+}
+
+bool GLGpuSim::available()
+{
+	return objects != 0;
+}
+
+GLuint GLGpuSim::object_buffer()
+{
+	return objects;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuSim::select(bool gpu)
+
+@brief
+	This function switches between the backends. The GPU backend starts by
+	uploading every live object with the next update. The CPU backend takes
+	over the angles integrated on the GPU, which waits for the GPU once;
+	the other attributes never change after spawning.
+
+@param gpu
+	true to simulate on the GPU
+
+@return none
+*/
+void GLGpuSim::select(bool gpu)
+{
+	if (gpu == GLGpuSim::enabled || (gpu && !GLGpuSim::available()))
+	{
+		return;
+	}
+
+	if (gpu)
+	{
+		uploaded = GLApp::objects.head;
+	}
+	else
+	{
+		GLApp::objects.for_each_range([](size_t begin, size_t end) {
+			staging.resize(end - begin);
+			glGetNamedBufferSubData(objects, sizeof(GLGpuCull::Object) * begin,
+				sizeof(GLGpuCull::Object) * staging.size(), staging.data());
+			for (size_t i = begin; i < end; i++)
+			{
+				GLApp::objects.angle_disp[i] = staging[i - begin].angle;
+			}
+		});
+	}
+	GLGpuSim::enabled = gpu;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGpuSim::update(GLdouble delta_time)
+
+@brief
+	This function uploads the objects spawned since the last call, skipping
+	those already killed, and integrates the angles of the live objects.
+	The barrier makes the states visible to GPU culling, and orders the
+	next frame's uploads after this frame's writes.
+
+@param delta_time
+	seconds since the last frame
+
+@return none
+*/
+void GLGpuSim::update(GLdouble delta_time)
+{
+	GLProfiler::Scope const scope("simulate");
+	GLApp::GLObjects const& objs = GLApp::objects;
+
+	// Part 1: The spawn deltas
+	upload(std::max(uploaded, objs.head), objs.tail);
+	uploaded = objs.tail;
+	if (objs.empty())
+	{
+		return;
+	}
+
+	// Part 2: One invocation per live object
+	GLuint const count = static_cast<GLuint>(objs.size());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, objects);
+	sim_pgm.Use();
+	sim_pgm.SetUniform(uniforms.count, static_cast<GLint>(count));
+	sim_pgm.SetUniform(uniforms.first, static_cast<GLint>(objs.slot(objs.head)));
+	sim_pgm.SetUniform(uniforms.capacity, static_cast<GLint>(objs.capacity()));
+	sim_pgm.SetUniform(uniforms.delta_time, static_cast<GLfloat>(delta_time));
+	GLGpuCull::dispatch_groups((count + GROUP_SIZE - 1) / GROUP_SIZE);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
@@ -0,0 +1,300 @@
+/*!
+@file		glgrid.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the loose uniform grid declared in glgrid.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glgrid.h>
+
+#include <algorithm>								// std::max
+#include <cmath>									// std::floor
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+constexpr GLuint GLGrid::NONE;
+constexpr size_t GLGrid::SORT_GRAIN;
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::init(glm::vec2 world_min, glm::vec2 world_max, GLuint cx, GLuint cy, size_t capacity)
+
+@brief
+	This function allocates the cells and the per-object arrays. Nothing is
+	allocated afterwards except when a cell holds more objects than it ever
+	did before.
+
+@return none
+*/
+void GLGrid::init(glm::vec2 world_min, glm::vec2 world_max, GLuint cx, GLuint cy, size_t capacity)
+{
+	cells_x = std::max(cx, 1u);
+	cells_y = std::max(cy, 1u);
+	origin = world_min;
+	inv_cell_size = glm::vec2(cells_x, cells_y) / (world_max - world_min);
+
+	cells.assign(static_cast<size_t>(cells_x) * cells_y, Cell{});
+	centers.assign(capacity, glm::vec2(0.0f));
+	radii.assign(capacity, 0.0f);
+	cell_of.assign(capacity, NONE);
+	index_in_cell.assign(capacity, 0);
+	by_band.assign(capacity, 0);
+	clear();
+}
+
+void GLGrid::clear()
+{
+	for (Cell& cell : cells)
+	{
+		cell.objects.clear();
+	}
+	std::fill(cell_of.begin(), cell_of.end(), NONE);
+	max_radius = 0.0f;
+	count = 0;
+}
+
+GLuint GLGrid::column(GLfloat x) const
+{
+	GLfloat const c = std::floor((x - origin.x) * inv_cell_size.x);
+	return static_cast<GLuint>(glm::clamp(c, 0.0f, static_cast<GLfloat>(cells_x - 1)));
+}
+
+GLuint GLGrid::row(GLfloat y) const
+{
+	GLfloat const r = std::floor((y - origin.y) * inv_cell_size.y);
+	return static_cast<GLuint>(glm::clamp(r, 0.0f, static_cast<GLfloat>(cells_y - 1)));
+}
+
+GLuint GLGrid::cell_index(glm::vec2 center) const
+{
+	return row(center.y) * cells_x + column(center.x);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::sort_by_band(GLuint first, GLuint last)
+
+@brief
+	This function counting-sorts objects [first, last) by the band of their
+	cells into by_band: every chunk of SORT_GRAIN objects counts its
+	objects per band in parallel, an exclusive prefix sum over the counts,
+	band by band and chunk by chunk, gives every chunk its place within
+	every band, and the chunks then scatter their objects in parallel. The
+	objects of a band keep their order.
+
+@return none
+*/
+void GLGrid::sort_by_band(GLuint first, GLuint last)
+{
+	size_t const n = last - first;
+	bands = std::max<size_t>(std::min<size_t>(GLJobs::thread_count(), cells.size()), 1);
+	cells_per_band = (cells.size() + bands - 1) / bands;
+	size_t const chunks = (n + SORT_GRAIN - 1) / SORT_GRAIN;
+	chunk_offsets.assign(chunks * bands, 0);
+
+	// Part 1: Objects of each band in each chunk
+	GLJobs::Fence fence;
+	GLJobs::parallel_for(0, chunks, 1, [this, first, last](size_t j0, size_t j1) {
+		for (size_t j = j0; j < j1; j++)
+		{
+			size_t* const counts = &chunk_offsets[j * bands];
+			GLuint const end = static_cast<GLuint>(std::min<size_t>(last, first + (j + 1) * SORT_GRAIN));
+			for (GLuint object = static_cast<GLuint>(first + j * SORT_GRAIN); object < end; object++)
+			{
+				counts[cell_of[object] / cells_per_band]++;
+			}
+		}
+	}, fence);
+	GLJobs::wait(fence);
+
+	// Part 2: Where each chunk's objects of each band start
+	band_start.resize(bands + 1);
+	size_t offset = 0;
+	for (size_t b = 0; b < bands; b++)
+	{
+		band_start[b] = offset;
+		for (size_t j = 0; j < chunks; j++)
+		{
+			size_t const cnt = chunk_offsets[j * bands + b];
+			chunk_offsets[j * bands + b] = offset;
+			offset += cnt;
+		}
+	}
+	band_start[bands] = offset;
+
+	// Part 3: Scatter
+	GLJobs::parallel_for(0, chunks, 1, [this, first, last](size_t j0, size_t j1) {
+		for (size_t j = j0; j < j1; j++)
+		{
+			size_t* const offsets = &chunk_offsets[j * bands];
+			GLuint const end = static_cast<GLuint>(std::min<size_t>(last, first + (j + 1) * SORT_GRAIN));
+			for (GLuint object = static_cast<GLuint>(first + j * SORT_GRAIN); object < end; object++)
+			{
+				by_band[offsets[cell_of[object] / cells_per_band]++] = object;
+			}
+		}
+	}, fence);
+	GLJobs::wait(fence);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::insert(GLuint object, glm::vec2 center, GLfloat radius)
+
+@brief
+	This function appends object to the cell of center and grows the cell's
+	bounding box by the circle.
+
+@return none
+*/
+void GLGrid::insert(GLuint object, glm::vec2 center, GLfloat radius)
+{
+	GLuint const c = cell_index(center);
+	Cell& cell = cells[c];
+	glm::vec2 const lo = center - radius, hi = center + radius;
+	if (cell.objects.empty())
+	{
+		cell.lo = lo;
+		cell.hi = hi;
+	}
+	else
+	{
+		cell.lo = glm::min(cell.lo, lo);
+		cell.hi = glm::max(cell.hi, hi);
+	}
+
+	centers[object] = center;
+	radii[object] = radius;
+	cell_of[object] = c;
+	index_in_cell[object] = static_cast<GLuint>(cell.objects.size());
+	cell.objects.push_back(object);
+
+	max_radius = std::max(max_radius, radius);
+	count++;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::remove(GLuint object)
+
+@brief
+	This function removes object from its cell by moving the cell's last
+	object into its place.
+
+@return none
+*/
+void GLGrid::remove(GLuint object)
+{
+	unlink(object);
+	if (--count == 0)
+	{
+		max_radius = 0.0f;
+	}
+}
+
+void GLGrid::unlink(GLuint object)
+{
+	Cell& cell = cells[cell_of[object]];
+	GLuint const last = cell.objects.back();
+	cell.objects[index_in_cell[object]] = last;
+	index_in_cell[last] = index_in_cell[object];
+	cell.objects.pop_back();
+	cell_of[object] = NONE;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::remove(GLuint first, GLuint last)
+
+@brief
+	This function removes objects [first, last) from their cells, each band
+	of cells in parallel with the others, visiting only its own objects.
+
+@return none
+*/
+void GLGrid::remove(GLuint first, GLuint last)
+{
+	sort_by_band(first, last);
+	GLJobs::Fence fence;
+	GLJobs::parallel_for(0, bands, 1, [this](size_t b0, size_t b1) {
+		for (size_t i = band_start[b0]; i < band_start[b1]; i++)
+		{
+			unlink(by_band[i]);
+		}
+	}, fence);
+	GLJobs::wait(fence);
+
+	count -= last - first;
+	if (count == 0)
+	{
+		max_radius = 0.0f;
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::link(GLuint first, GLuint last)
+
+@brief
+	This function appends objects [first, last) to the cells set by
+	insert, each band of cells in parallel with the others, in the order
+	of the objects, and grows the cells' bounding boxes by their circles.
+
+@return none
+*/
+void GLGrid::link(GLuint first, GLuint last)
+{
+	sort_by_band(first, last);
+	GLJobs::Fence fence;
+	GLJobs::parallel_for(0, bands, 1, [this](size_t b0, size_t b1) {
+		for (size_t i = band_start[b0]; i < band_start[b1]; i++)
+		{
+			GLuint const object = by_band[i];
+			Cell& cell = cells[cell_of[object]];
+			glm::vec2 const lo = centers[object] - radii[object], hi = centers[object] + radii[object];
+			if (cell.objects.empty())
+			{
+				cell.lo = lo;
+				cell.hi = hi;
+			}
+			else
+			{
+				cell.lo = glm::min(cell.lo, lo);
+				cell.hi = glm::max(cell.hi, hi);
+			}
+			index_in_cell[object] = static_cast<GLuint>(cell.objects.size());
+			cell.objects.push_back(object);
+		}
+	}, fence);
+	GLJobs::wait(fence);
+
+	for (GLuint object = first; object < last; object++)
+	{
+		max_radius = std::max(max_radius, radii[object]);
+	}
+	count += last - first;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLGrid::move(GLuint object, glm::vec2 center, GLfloat radius)
+
+@brief
+	This function updates the circle of object. The object only changes
+	cell if its centre crossed into another one.
+
+@return none
+*/
+void GLGrid::move(GLuint object, glm::vec2 center, GLfloat radius)
+{
+	if (cell_of[object] != cell_index(center))
+	{
+		remove(object);
+		insert(object, center, radius);
+		return;
+	}
+
+	Cell& cell = cells[cell_of[object]];
+	cell.lo = glm::min(cell.lo, center - radius);
+	cell.hi = glm::max(cell.hi, center + radius);
+	centers[object] = center;
+	radii[object] = radius;
+	max_radius = std::max(max_radius, radius);
+}
@@ -15,6 +15,12 @@ pointers to OpenGL implementations.
 ----------------------------------------------------------------------------- */
 #include <glhelper.h>
 #include <iostream>
+#include <chrono>
+
+#ifdef GLHELPER_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
 
 /*                                                   objects with file scope
 ----------------------------------------------------------------------------- */
@@ -25,12 +31,100 @@ GLdouble GLHelper::fps;
 GLdouble GLHelper::delta_time;
 std::string GLHelper::title;
 GLFWwindow* GLHelper::ptr_window;
+bool GLHelper::headless;
+GLuint GLHelper::offscreen_fbo;
+GLuint GLHelper::offscreen_color;
 
 GLboolean GLHelper::keystateP = GL_FALSE;
+GLboolean GLHelper::keystateG = GL_FALSE;
 GLboolean GLHelper::LMouseState = GL_FALSE;
+GLdouble GLHelper::scroll_offset = 0.0;
 
 #define UNREFERENCED_PARAMETER(P)(P)
 
+// printed when an offscreen window can't be created
+static char const NO_DISPLAY_HINT[] = "Headless runs still need a display; on Linux, run under "
+    "Xvfb (xvfb-run -a) or build with GLHELPER_EGL\n";
+
+#ifdef GLHELPER_EGL
+// display and context of the surfaceless EGL context, if one was created
+static EGLDisplay egl_display = EGL_NO_DISPLAY;
+static EGLContext egl_context = EGL_NO_CONTEXT;
+static std::chrono::steady_clock::time_point egl_start;
+
+/*  _________________________________________________________________________ */
+/*! init_egl
+
+@return bool
+true if a surfaceless OpenGL 4.5 core context was made current.
+
+Creates a context on the Mesa surfaceless platform, which renders without
+a window, display server or GPU (llvmpipe). GLEW has to be built with
+GLEW_EGL to load the OpenGL entry points of such a context.
+*/
+static bool init_egl() {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC const get_platform_display =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!get_platform_display) {
+        std::cerr << "EGL_EXT_platform_base is not supported" << std::endl;
+        return false;
+    }
+
+    egl_display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (egl_display == EGL_NO_DISPLAY || !eglInitialize(egl_display, nullptr, nullptr)) {
+        std::cerr << "Unable to initialize surfaceless EGL display" << std::endl;
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL doesn't support desktop OpenGL" << std::endl;
+        return false;
+    }
+
+    EGLint const context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    // EGL_KHR_no_config_context: the context renders only into framebuffer objects
+    egl_context = eglCreateContext(egl_display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attribs);
+    if (egl_context == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, egl_context)) {
+        std::cerr << "Unable to create surfaceless OpenGL 4.5 context" << std::endl;
+        return false;
+    }
+
+    egl_start = std::chrono::steady_clock::now();
+    return true;
+}
+#endif
+
+/*  _________________________________________________________________________ */
+/*! init_offscreen
+
+@return bool
+true if the offscreen framebuffer is complete.
+
+Creates a width x height framebuffer with a 32-bit RGBA color buffer and
+binds it, so that everything rendered by the application goes into it
+instead of the window's back buffer.
+*/
+static bool init_offscreen() {
+    glCreateRenderbuffers(1, &GLHelper::offscreen_color);
+    glNamedRenderbufferStorage(GLHelper::offscreen_color, GL_RGBA8, GLHelper::width, GLHelper::height);
+
+    glCreateFramebuffers(1, &GLHelper::offscreen_fbo);
+    glNamedFramebufferRenderbuffer(GLHelper::offscreen_fbo, GL_COLOR_ATTACHMENT0,
+        GL_RENDERBUFFER, GLHelper::offscreen_color);
+    if (glCheckNamedFramebufferStatus(GLHelper::offscreen_fbo, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+        return false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, GLHelper::offscreen_fbo);
+    return true;
+}
+
 /*  _________________________________________________________________________ */
 /*! init
 
@@ -41,6 +135,9 @@ Dimensions of window requested by program
 @param std::string title_str
 String printed to window's title bar
 
+@param bool offscreen
+Render into an offscreen framebuffer instead of a visible window
+
 @return bool
 true if OpenGL context and GLEW were successfully initialized.
 false otherwise.
@@ -52,48 +149,70 @@ and its associated OpenGL context that matches a core profile that is
 compatible with OpenGL 4.5 and doesn't support "old" OpenGL, has 32-bit RGBA,
 double-buffered color buffer, 24-bit depth buffer and 8-bit stencil buffer
 with each buffer of size width x height pixels
+When offscreen, the window is created invisible (or, with GLHELPER_EGL, no
+window is created at all) and an offscreen framebuffer of the same size is
+bound instead. An invisible window still needs a display, so without one
+creating it fails.
 */
-bool GLHelper::init(GLint w, GLint h, std::string t) {
+bool GLHelper::init(GLint w, GLint h, std::string t, bool offscreen) {
     GLHelper::width = w;
     GLHelper::height = h;
     GLHelper::title = t;
+    GLHelper::headless = offscreen;
 
-    // Part 1
-    if (!glfwInit()) {
-        std::cout << "GLFW init has failed - abort program!!!" << std::endl;
-        return false;
+#ifdef GLHELPER_EGL
+    if (offscreen) {
+        if (!init_egl()) {
+            return false;
+        }
     }
+    else
+#endif
+    {
+        // Part 1
+        if (!glfwInit()) {
+            std::cout << "GLFW init has failed - abort program!!!" << std::endl;
+            if (offscreen) {
+                std::cerr << NO_DISPLAY_HINT;
+            }
+            return false;
+        }
 
-    // In case a GLFW function fails, an error is reported to callback function
-    glfwSetErrorCallback(GLHelper::error_cb);
-
-    // Before asking GLFW to create an OpenGL context, we specify the minimum constraints
-    // in that context:
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_TRUE);
-    glfwWindowHint(GLFW_RED_BITS, 8); glfwWindowHint(GLFW_GREEN_BITS, 8);
-    glfwWindowHint(GLFW_BLUE_BITS, 8); glfwWindowHint(GLFW_ALPHA_BITS, 8);
-    glfwWindowHint(GLFW_RESIZABLE, GL_FALSE); // window dimensions are static
-
-    GLHelper::ptr_window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
-    if (!GLHelper::ptr_window) {
-        std::cerr << "GLFW unable to create OpenGL context - abort program\n";
-        glfwTerminate();
-        return false;
-    }
+        // In case a GLFW function fails, an error is reported to callback function
+        glfwSetErrorCallback(GLHelper::error_cb);
+
+        // Before asking GLFW to create an OpenGL context, we specify the minimum constraints
+        // in that context:
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_TRUE);
+        glfwWindowHint(GLFW_RED_BITS, 8); glfwWindowHint(GLFW_GREEN_BITS, 8);
+        glfwWindowHint(GLFW_BLUE_BITS, 8); glfwWindowHint(GLFW_ALPHA_BITS, 8);
+        glfwWindowHint(GLFW_RESIZABLE, GL_FALSE); // window dimensions are static
+        glfwWindowHint(GLFW_VISIBLE, offscreen ? GLFW_FALSE : GLFW_TRUE);
+
+        GLHelper::ptr_window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
+        if (!GLHelper::ptr_window) {
+            std::cerr << "GLFW unable to create OpenGL context - abort program\n";
+            if (offscreen) {
+                std::cerr << NO_DISPLAY_HINT;
+            }
+            glfwTerminate();
+            return false;
+        }
 
-    glfwMakeContextCurrent(GLHelper::ptr_window);
+        glfwMakeContextCurrent(GLHelper::ptr_window);
 
-    glfwSetFramebufferSizeCallback(GLHelper::ptr_window, GLHelper::fbsize_cb);
-    glfwSetKeyCallback(GLHelper::ptr_window, GLHelper::key_cb);
-    glfwSetMouseButtonCallback(GLHelper::ptr_window, GLHelper::mousebutton_cb);
-    glfwSetCursorPosCallback(GLHelper::ptr_window, GLHelper::mousepos_cb);
-    glfwSetScrollCallback(GLHelper::ptr_window, GLHelper::mousescroll_cb);
+        glfwSetFramebufferSizeCallback(GLHelper::ptr_window, GLHelper::fbsize_cb);
+        glfwSetKeyCallback(GLHelper::ptr_window, GLHelper::key_cb);
+        glfwSetMouseButtonCallback(GLHelper::ptr_window, GLHelper::mousebutton_cb);
+        glfwSetCursorPosCallback(GLHelper::ptr_window, GLHelper::mousepos_cb);
+        glfwSetScrollCallback(GLHelper::ptr_window, GLHelper::mousescroll_cb);
 
-    // this is the default setting ...
-    glfwSetInputMode(GLHelper::ptr_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+        // this is the default setting ...
+        glfwSetInputMode(GLHelper::ptr_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    }
 
     // Part 2: Initialize entry points to OpenGL functions and extensions
     GLenum err = glewInit();
@@ -111,6 +230,11 @@ bool GLHelper::init(GLint w, GLint h, std::string t) {
         return false;
     }
 
+    // Part 3: Redirect rendering into the offscreen framebuffer
+    if (offscreen && !init_offscreen()) {
+        return false;
+    }
+
     return true;
 }
 
@@ -128,6 +252,23 @@ gracefully terminate.
 */
 void GLHelper::cleanup() {
     // Part 1
+    if (GLHelper::offscreen_fbo) {
+        glDeleteFramebuffers(1, &GLHelper::offscreen_fbo);
+        glDeleteRenderbuffers(1, &GLHelper::offscreen_color);
+        GLHelper::offscreen_fbo = GLHelper::offscreen_color = 0;
+    }
+
+    // Part 2
+#ifdef GLHELPER_EGL
+    if (egl_display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(egl_display, egl_context);
+        eglTerminate(egl_display);
+        egl_display = EGL_NO_DISPLAY;
+        egl_context = EGL_NO_CONTEXT;
+        return;
+    }
+#endif
     glfwTerminate();
 }
 
@@ -171,6 +312,7 @@ void GLHelper::key_cb(GLFWwindow* pwin, int key, int scancode, int
         std::cout << "Pressed/Triggered (Mouse)\n";
 #endif
         keystateP = (key == GLFW_KEY_P) ? GL_TRUE : GL_FALSE;
+        keystateG = (key == GLFW_KEY_G) ? GL_TRUE : GL_FALSE;
     }
     else if (GLFW_REPEAT == action) {
 #ifdef _DEBUG
@@ -178,6 +320,7 @@ void GLHelper::key_cb(GLFWwindow* pwin, int key, int scancode, int
 #endif
         // key state was and is being pressed
         keystateP = GL_FALSE;
+        keystateG = GL_FALSE;
     }
     else if (GLFW_RELEASE == action) {
 #ifdef _DEBUG
@@ -185,6 +328,7 @@ void GLHelper::key_cb(GLFWwindow* pwin, int key, int scancode, int
 #endif
         // key start changes from pressed to released
         keystateP = GL_FALSE;
+        keystateG = GL_FALSE;
     }
 }
 
@@ -295,14 +439,17 @@ Scroll offset along Y-axis
 
 This function is called when the user scrolls, whether with a mouse wheel or
 touchpad gesture. Although the function receives 2D scroll offsets, a simple
-mouse scroll wheel, being vertical, provides offsets only along the Y-axis.
+mouse scroll wheel, being vertical, provides offsets only along the Y-axis,
+which are accumulated in scroll_offset for the camera.
 */
 void GLHelper::mousescroll_cb(GLFWwindow* pwin, double xoffset, double yoffset) {
 
 
     UNREFERENCED_PARAMETER(pwin);
     UNREFERENCED_PARAMETER(xoffset);
-    UNREFERENCED_PARAMETER(yoffset);
+
+    // accumulated until the camera zooms in the next update
+    scroll_offset += yoffset;
 
 #ifdef _DEBUG
     std::cout << "Mouse scroll wheel offset: ("
@@ -376,14 +523,14 @@ to compute:
 */
 void GLHelper::update_time(double fps_calc_interval) {
     // get elapsed time (in seconds) between previous and current frames
-    static double prev_time = glfwGetTime();
-    double curr_time = glfwGetTime();
+    static double prev_time = GLHelper::time();
+    double curr_time = GLHelper::time();
     delta_time = curr_time - prev_time;
     prev_time = curr_time;
 
     // fps calculations
     static double count = 0.0; // number of game loop iterations
-    static double start_time = glfwGetTime();
+    static double start_time = GLHelper::time();
     // get elapsed time since very beginning (in seconds) ...
     double elapsed_time = curr_time - start_time;
 
@@ -401,6 +548,22 @@ void GLHelper::update_time(double fps_calc_interval) {
 
 
 
+/*  _________________________________________________________________________*/
+/*! time
+
+@return double
+seconds elapsed since the context was created
+
+Uses GLFW's timer, or a steady clock when there is no GLFW window.
+*/
+double GLHelper::time() {
+#ifdef GLHELPER_EGL
+    if (egl_display != EGL_NO_DISPLAY) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - egl_start).count();
+    }
+#endif
+    return glfwGetTime();
+}
 
 
 
@@ -0,0 +1,183 @@
+/*!
+@file		glhud.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the stats overlay declared in glhud.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glhud.h>
+#include <glhelper.h>
+#include <glslshader.h>
+#include <glstate.h>
+
+#include <stb_easy_font.h>							// stb_easy_font_print
+#include <cstring>									// std::strncpy
+#include <string>									// std::string
+#include <utility>									// std::pair
+#include <vector>									// std::vector
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+double GLHud::refresh_interval = 0.25;
+GLfloat GLHud::scale = 2.0f;
+
+namespace {
+
+	// layout of the vertices written by stb_easy_font_print
+	struct HudVertex {
+		GLfloat x, y, z;
+		GLubyte color[4];
+	};
+
+	constexpr size_t VERTICES_PER_QUAD = 4;
+	constexpr size_t INDICES_PER_QUAD = 6;
+
+	GLSLShader shdr_pgm;
+	GLSLShader::Uniform<glm::vec2> pixel_to_ndc;
+
+	GLuint vaoid = 0;
+	GLuint vbo = 0;
+	GLuint ebo = 0;
+	GLsizei index_cnt = 0;							// indices of the current text
+	double last_update = -1.0;						// time the text was last set
+
+	// staging area of stb_easy_font_print; static so that generating text
+	// doesn't allocate
+	HudVertex vertices[GLHud::MAX_QUADS * VERTICES_PER_QUAD];
+	char text_copy[GLHud::MAX_TEXT];
+}
+
+/*  _________________________________________________________________________*/
+/*! GLHud::init()
+
+@brief
+	This function compiles the overlay's shader program and creates its VAO
+	with a vertex buffer for MAX_QUADS quads and an index buffer that splits
+	each quad into two triangles.
+
+@return none
+*/
+void GLHud::init()
+{
+	// Part 1: shader program
+	std::vector<std::pair<GLenum, std::string>> shdr_files{
+		std::make_pair(GL_VERTEX_SHADER, std::string("../shaders/hud.vert")),
+		std::make_pair(GL_FRAGMENT_SHADER, std::string("../shaders/hud.frag"))
+	};
+	shdr_pgm.CompileLinkValidate(shdr_files);
+	pixel_to_ndc = shdr_pgm.GetUniform<glm::vec2>("uPixelToNDC");
+
+	// Part 2: vertex buffer, written whenever the text changes
+	glCreateBuffers(1, &vbo);
+	glNamedBufferStorage(vbo, sizeof(vertices), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	// Part 3: index buffer; quad q is made of triangles (4q, 4q+1, 4q+2)
+	// and (4q, 4q+2, 4q+3)
+	std::vector<GLushort> indices(MAX_QUADS * INDICES_PER_QUAD);
+	for (size_t q = 0; q < MAX_QUADS; q++)
+	{
+		GLushort const v = static_cast<GLushort>(q * VERTICES_PER_QUAD);
+		GLushort const quad[INDICES_PER_QUAD] = {
+			v, static_cast<GLushort>(v + 1), static_cast<GLushort>(v + 2),
+			v, static_cast<GLushort>(v + 2), static_cast<GLushort>(v + 3)
+		};
+		std::memcpy(&indices[q * INDICES_PER_QUAD], quad, sizeof(quad));
+	}
+	glCreateBuffers(1, &ebo);
+	glNamedBufferStorage(ebo, indices.size() * sizeof(GLushort), indices.data(), 0);
+
+	// Part 4: VAO
+	glCreateVertexArrays(1, &vaoid);
+	glVertexArrayVertexBuffer(vaoid, 0, vbo, 0, sizeof(HudVertex));
+	glVertexArrayElementBuffer(vaoid, ebo);
+
+	glEnableVertexArrayAttrib(vaoid, 0);
+	glVertexArrayAttribFormat(vaoid, 0, 3, GL_FLOAT, GL_FALSE, offsetof(HudVertex, x));
+	glVertexArrayAttribBinding(vaoid, 0, 0);
+
+	glEnableVertexArrayAttrib(vaoid, 1);
+	glVertexArrayAttribFormat(vaoid, 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(HudVertex, color));
+	glVertexArrayAttribBinding(vaoid, 1, 0);
+
+	index_cnt = 0;
+	last_update = -1.0;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLHud::cleanup()
+
+@brief
+	This function deletes the overlay's buffers, VAO and shader program.
+
+@return none
+*/
+void GLHud::cleanup()
+{
+	glDeleteVertexArrays(1, &vaoid);
+	glDeleteBuffers(1, &vbo);
+	glDeleteBuffers(1, &ebo);
+	shdr_pgm.DeleteShaderProgram();
+	vaoid = vbo = ebo = 0;
+}
+
+bool GLHud::due()
+{
+	return last_update < 0.0 || GLHelper::time() - last_update >= refresh_interval;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLHud::set_text(char const* text)
+
+@brief
+	This function generates the quads of text, in black, starting at the
+	top-left corner of the viewport, and uploads them. Text that doesn't fit
+	in MAX_TEXT characters or MAX_QUADS quads is cut off.
+
+@param text
+	null-terminated text; lines are separated by '\n'
+
+@return none
+*/
+void GLHud::set_text(char const* text)
+{
+	// stb_easy_font_print takes a non-const string
+	std::strncpy(text_copy, text, MAX_TEXT - 1);
+	text_copy[MAX_TEXT - 1] = '\0';
+
+	unsigned char black[4] = { 0, 0, 0, 255 };
+	int const quad_cnt = stb_easy_font_print(4.0f, 4.0f, text_copy, black,
+		vertices, static_cast<int>(sizeof(vertices)));
+
+	glNamedBufferSubData(vbo, 0, quad_cnt * VERTICES_PER_QUAD * sizeof(HudVertex), vertices);
+	index_cnt = static_cast<GLsizei>(quad_cnt * INDICES_PER_QUAD);
+	last_update = GLHelper::time();
+}
+
+/*  _________________________________________________________________________*/
+/*! GLHud::draw()
+
+@brief
+	This function renders every quad of the current text with one draw
+	call. The overlay is always filled, whatever polygon mode the scene was
+	drawn with.
+
+@return none
+*/
+void GLHud::draw()
+{
+	if (index_cnt == 0)
+	{
+		return;
+	}
+
+	GLState::polygon_mode(GL_FILL);
+
+	shdr_pgm.Use();
+	shdr_pgm.SetUniform(pixel_to_ndc, glm::vec2(2.0f * scale / GLHelper::width, -2.0f * scale / GLHelper::height));
+	GLState::bind_vertex_array(vaoid);
+	glDrawElements(GL_TRIANGLES, index_cnt, GL_UNSIGNED_SHORT, NULL);
+}
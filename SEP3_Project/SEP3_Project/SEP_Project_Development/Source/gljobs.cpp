@@ -0,0 +1,410 @@
+/*!
+@file		gljobs.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the job system declared in gljobs.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <gljobs.h>
+
+#include <algorithm>								// std::max, std::min
+#include <condition_variable>						// std::condition_variable
+#include <memory>									// std::unique_ptr
+#include <mutex>									// std::mutex
+#include <thread>									// std::thread
+#include <vector>									// std::vector
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	// Record of one submission, shared by its tasks: the job, or the range
+	// function of a parallel_for, and the number of its tasks still to run.
+	// Records are recycled, so submitting doesn't allocate once the pool has
+	// grown to the number of submissions in flight.
+	struct Submission {
+		GLJobs::Job job;
+		GLJobs::RangeFn fn;
+		std::atomic<size_t> remaining{ 0 };
+	};
+
+	// a queued task, run(*submission, begin, end), and the fence it is
+	// accounted against
+	struct Task {
+		void (*run)(Submission& s, size_t begin, size_t end);
+		Submission* submission;
+		size_t begin;
+		size_t end;
+		GLJobs::Fence* fence;
+	};
+
+	// Work-stealing queue owned by one thread. The owner pushes and pops at
+	// the back; other threads steal from the front. The tasks are a ring
+	// buffer that grows when full and keeps its capacity.
+	struct Queue {
+		std::mutex mutex;
+		std::vector<Task> ring;						// capacity is a power of two
+		size_t head = 0;
+		size_t count = 0;
+
+		void push_back(Task const& t)
+		{
+			if (count == ring.size())
+			{
+				std::vector<Task> bigger(std::max<size_t>(ring.size() * 2, 256));
+				for (size_t i = 0; i < count; i++)
+				{
+					bigger[i] = ring[(head + i) & (ring.size() - 1)];
+				}
+				ring.swap(bigger);
+				head = 0;
+			}
+			ring[(head + count) & (ring.size() - 1)] = t;
+			count++;
+		}
+
+		Task pop_back()
+		{
+			count--;
+			return ring[(head + count) & (ring.size() - 1)];
+		}
+
+		Task pop_front()
+		{
+			Task const t = ring[head];
+			head = (head + 1) & (ring.size() - 1);
+			count--;
+			return t;
+		}
+	};
+
+	// queues[0] belongs to the thread that called GLJobs::init (and to any
+	// other thread that isn't a worker), queues[i] to worker i
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+
+	// every submission record, and those not in use
+	std::mutex pool_mutex;
+	std::vector<std::unique_ptr<Submission>> submissions;
+	std::vector<Submission*> free_submissions;
+
+	// Number of tasks in all queues; idle workers sleep while it is 0. It is
+	// raised before the tasks are queued, so that it never drops below the
+	// number of tasks that can be taken.
+	std::atomic<size_t> queued{ 0 };
+	std::mutex sleep_mutex;
+	std::condition_variable sleep_cv;
+	bool stopping = false;
+
+	// index of the queue owned by the calling thread
+	thread_local size_t queue_index = 0;
+
+	/*  _________________________________________________________________________*/
+	/*! acquire, release
+
+	@brief
+		These functions take a submission record of task_cnt tasks from the
+		pool and give it back once its last task has run, dropping what the
+		job or range function captured.
+
+	@return Submission& / none
+	*/
+	Submission& acquire(size_t task_cnt)
+	{
+		Submission* s = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(pool_mutex);
+			if (free_submissions.empty())
+			{
+				submissions.emplace_back(std::make_unique<Submission>());
+				s = submissions.back().get();
+			}
+			else
+			{
+				s = free_submissions.back();
+				free_submissions.pop_back();
+			}
+		}
+		s->remaining.store(task_cnt, std::memory_order_relaxed);
+		return *s;
+	}
+
+	void release(Submission& s)
+	{
+		s.job = nullptr;
+		s.fn = nullptr;
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		free_submissions.push_back(&s);
+	}
+
+	void run_job(Submission& s, size_t, size_t)
+	{
+		s.job();
+	}
+
+	void run_range(Submission& s, size_t begin, size_t end)
+	{
+		s.fn(begin, end);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! push
+
+	@brief
+		This function appends task_cnt tasks, the i-th being make_task(i), to
+		the calling thread's queue and wakes up idle workers.
+
+	@return none
+	*/
+	template <typename MakeTask>
+	void push(size_t task_cnt, MakeTask make_task)
+	{
+		{
+			// hold the sleep mutex so a worker can't miss the update between
+			// checking queued and going to sleep
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			queued.fetch_add(task_cnt, std::memory_order_release);
+		}
+		Queue& q = *queues[queue_index];
+		{
+			std::lock_guard<std::mutex> lock(q.mutex);
+			for (size_t i = 0; i < task_cnt; i++)
+			{
+				q.push_back(make_task(i));
+			}
+		}
+		if (task_cnt == 1)
+		{
+			sleep_cv.notify_one();
+		}
+		else
+		{
+			sleep_cv.notify_all();
+		}
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! try_run_one
+
+	@brief
+		This function runs one task, taken from the back of the calling
+		thread's queue or, if that is empty, stolen from the front of
+		another thread's queue.
+
+	@return bool
+		true if a task was run
+	*/
+	bool try_run_one()
+	{
+		if (queued.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		Task task{};
+		bool found = false;
+		size_t const n = queues.size();
+		for (size_t k = 0; k < n && !found; k++)
+		{
+			size_t const idx = (queue_index + k) % n;
+			Queue& q = *queues[idx];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (q.count == 0)
+			{
+				continue;
+			}
+			task = (k == 0) ? q.pop_back() : q.pop_front();
+			found = true;
+		}
+		if (!found)
+		{
+			return false;
+		}
+
+		queued.fetch_sub(1, std::memory_order_relaxed);
+		task.run(*task.submission, task.begin, task.end);
+		if (task.submission->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			release(*task.submission);
+		}
+		task.fence->pending.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! worker_main
+
+	@brief
+		Entry point of worker threads: run tasks while there are any, sleep
+		otherwise.
+
+	@return none
+	*/
+	void worker_main(size_t index)
+	{
+		queue_index = index;
+		for (;;)
+		{
+			if (try_run_one())
+			{
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleep_mutex);
+			sleep_cv.wait(lock, [] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+			if (stopping && queued.load(std::memory_order_acquire) == 0)
+			{
+				return;
+			}
+		}
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLJobs::init(unsigned worker_cnt)
+
+@brief
+	This function creates one queue per thread and starts the workers.
+
+@param worker_cnt
+	number of worker threads; 0 selects hardware threads - 1
+
+@return none
+*/
+void GLJobs::init(unsigned worker_cnt)
+{
+	if (worker_cnt == 0)
+	{
+		unsigned const hw = std::thread::hardware_concurrency();
+		worker_cnt = (hw > 1) ? hw - 1 : 0;
+	}
+
+	stopping = false;
+	queue_index = 0;
+	queues.clear();
+	for (unsigned i = 0; i <= worker_cnt; i++)
+	{
+		queues.emplace_back(std::make_unique<Queue>());
+	}
+	for (unsigned i = 1; i <= worker_cnt; i++)
+	{
+		workers.emplace_back(worker_main, static_cast<size_t>(i));
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLJobs::cleanup()
+
+@brief
+	This function lets the workers drain the queues and joins them.
+
+@return none
+*/
+void GLJobs::cleanup()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stopping = true;
+	}
+	sleep_cv.notify_all();
+	for (std::thread& t : workers)
+	{
+		t.join();
+	}
+	workers.clear();
+
+	// run anything left over when there are no workers
+	while (try_run_one())
+	{
+	}
+	queues.clear();
+	free_submissions.clear();
+	submissions.clear();
+}
+
+unsigned GLJobs::thread_count()
+{
+	return static_cast<unsigned>(workers.size()) + 1;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLJobs::submit(Job job, Fence& fence)
+
+@brief
+	This function queues one job against fence. Without a pool the job runs
+	immediately on the calling thread.
+
+@return none
+*/
+void GLJobs::submit(Job job, Fence& fence)
+{
+	if (queues.empty())
+	{
+		job();
+		return;
+	}
+
+	Submission& s = acquire(1);
+	s.job = std::move(job);
+	fence.pending.fetch_add(1, std::memory_order_relaxed);
+	push(1, [&](size_t) { return Task{ run_job, &s, 0, 0, &fence }; });
+}
+
+/*  _________________________________________________________________________*/
+/*! GLJobs::parallel_for(size_t begin, size_t end, size_t grain, RangeFn fn, Fence& fence)
+
+@brief
+	This function splits [begin, end) into chunks of at most grain elements
+	and queues one task per chunk against fence; the tasks are plain
+	ranges of one shared copy of fn, so queuing them doesn't allocate.
+	When there are no workers or the range fits in a single chunk, fn runs
+	immediately on the calling thread.
+
+@return none
+*/
+void GLJobs::parallel_for(size_t begin, size_t end, size_t grain, RangeFn fn, Fence& fence)
+{
+	if (begin >= end)
+	{
+		return;
+	}
+	grain = std::max<size_t>(grain, 1);
+	if (workers.empty() || end - begin <= grain)
+	{
+		fn(begin, end);
+		return;
+	}
+
+	// the chunks share one copy of fn in the submission record
+	size_t const chunk_cnt = (end - begin + grain - 1) / grain;
+	Submission& s = acquire(chunk_cnt);
+	s.fn = std::move(fn);
+	fence.pending.fetch_add(chunk_cnt, std::memory_order_relaxed);
+	push(chunk_cnt, [&](size_t i) {
+		size_t const b = begin + i * grain;
+		return Task{ run_range, &s, b, std::min(end, b + grain), &fence };
+	});
+}
+
+/*  _________________________________________________________________________*/
+/*! GLJobs::wait(Fence& fence)
+
+@brief
+	This function runs queued jobs on the calling thread until every job
+	submitted against fence has finished.
+
+@return none
+*/
+void GLJobs::wait(Fence& fence)
+{
+	while (!fence.done())
+	{
+		if (!try_run_one())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
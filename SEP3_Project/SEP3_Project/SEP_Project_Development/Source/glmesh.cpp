@@ -0,0 +1,508 @@
+/*!
+@file		glmesh.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the cached mesh loader declared in glmesh.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glmesh.h>
+#include <glmeshopt.h>
+#include <dpml.h>
+
+#include <cstdio>									// std::remove, std::rename
+#include <cstring>									// std::memcpy, std::memcmp
+#include <fstream>									// std::ifstream, std::ofstream
+#include <iostream>									// std::cerr
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	constexpr char MAGIC[4] = { 'D', 'P', 'M', 'B' };
+	constexpr size_t ALIGNMENT = 16;
+
+	// header at the start of every cache file
+	struct Header {
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t flags;
+		std::uint32_t index_size;					// 2 or 4 bytes
+		std::int64_t source_mtime;
+		std::uint64_t source_size;
+		std::uint64_t source_hash;
+		std::uint64_t vertex_cnt;
+		std::uint64_t index_cnt;
+		std::uint64_t positions_offset;
+		std::uint64_t normals_offset;
+		std::uint64_t texcoords_offset;
+		std::uint64_t triangles_offset;
+		std::uint64_t file_size;
+	};
+
+	size_t align(size_t offset)
+	{
+		return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	// modification time and size of a file
+	bool file_stat(std::string const& path, std::int64_t& mtime, std::uint64_t& size)
+	{
+#ifdef _WIN32
+		struct _stat64 st;
+		if (_stat64(path.c_str(), &st) != 0)
+		{
+			return false;
+		}
+#else
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0)
+		{
+			return false;
+		}
+#endif
+		mtime = static_cast<std::int64_t>(st.st_mtime);
+		size = static_cast<std::uint64_t>(st.st_size);
+		return true;
+	}
+
+	// 64-bit FNV-1a hash of a file's contents
+	bool file_hash(std::string const& path, std::uint64_t& hash)
+	{
+		std::ifstream ifs(path, std::ios::binary);
+		if (!ifs)
+		{
+			return false;
+		}
+		hash = 14695981039346656037ull;
+		char buf[1 << 16];
+		while (ifs)
+		{
+			ifs.read(buf, sizeof(buf));
+			std::streamsize const n = ifs.gcount();
+			for (std::streamsize i = 0; i < n; i++)
+			{
+				hash ^= static_cast<unsigned char>(buf[i]);
+				hash *= 1099511628211ull;
+			}
+		}
+		return true;
+	}
+
+	bool read_file(std::string const& path, std::vector<std::uint8_t>& contents)
+	{
+		std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+		if (!ifs)
+		{
+			return false;
+		}
+		contents.resize(static_cast<size_t>(ifs.tellg()));
+		ifs.seekg(0);
+		return static_cast<bool>(ifs.read(reinterpret_cast<char*>(contents.data()),
+			static_cast<std::streamsize>(contents.size())));
+	}
+
+	// written under a temporary name and renamed over path, so that a reader
+	// finds the old file or the whole new one, never a truncated one
+	bool write_file(std::string const& path, void const* data, size_t size)
+	{
+		std::string const tmp_path = path + ".tmp";
+		{
+			std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+			ofs.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+			// a failed flush only shows once the file is closed
+			ofs.close();
+			if (!ofs)
+			{
+				std::remove(tmp_path.c_str());
+				return false;
+			}
+		}
+		// both replace an existing path in one step, which std::rename
+		// doesn't do on Windows
+#ifdef _WIN32
+		bool const replaced = MoveFileExA(tmp_path.c_str(), path.c_str(),
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		bool const replaced = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+#endif
+		if (!replaced)
+		{
+			std::remove(tmp_path.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	// true if cnt elements of elem_size bytes from offset lie within size
+	// bytes; the fields of a corrupt header can't overflow the test
+	bool fits(std::uint64_t offset, std::uint64_t cnt, std::uint64_t elem_size, size_t size)
+	{
+		return offset <= size && cnt <= (size - offset) / elem_size;
+	}
+
+	bool read_header(std::string const& path, Header& hdr)
+	{
+		std::ifstream ifs(path, std::ios::binary);
+		return ifs && ifs.read(reinterpret_cast<char*>(&hdr), sizeof(hdr))
+			&& std::memcmp(hdr.magic, MAGIC, sizeof(MAGIC)) == 0
+			&& hdr.version == GLMesh::VERSION;
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! build_image
+
+	@brief
+		This function parses (and, if requested, optimizes) the OBJ file and
+		lays the result out exactly as the cache file stores it.
+
+	@return bool
+		false if the OBJ file can't be parsed
+	*/
+	bool build_image(std::string const& obj_path, std::uint32_t flags, Header hdr,
+		std::vector<std::uint8_t>& image)
+	{
+		std::vector<glm::vec3> positions, normals;
+		std::vector<glm::vec2> texcoords;
+		std::vector<unsigned int> triangles;
+		if (!DPML::parse_obj_mesh(obj_path, positions, normals, texcoords, triangles,
+			(flags & GLMesh::NORMALS) != 0, (flags & GLMesh::TEXCOORDS) != 0,
+			(flags & GLMesh::CENTERED) != 0))
+		{
+			return false;
+		}
+
+		// the optimized order is cached, so the passes only run when the
+		// OBJ file changes
+		if (flags & GLMesh::OPTIMIZE)
+		{
+			GLMeshOpt::optimize(positions, normals, texcoords, triangles,
+				(flags & GLMesh::OVERDRAW) != 0, &std::cout);
+		}
+
+		// keep the indices 16-bit whenever they fit
+		std::vector<unsigned short> triangles16;
+		if (GLMesh::index_type_for(positions.size()) == GL_UNSIGNED_SHORT)
+		{
+			triangles16.assign(triangles.begin(), triangles.end());
+		}
+		size_t const index_size = triangles16.empty() ? sizeof(unsigned int) : sizeof(unsigned short);
+		void const* const index_data = triangles16.empty()
+			? static_cast<void const*>(triangles.data()) : static_cast<void const*>(triangles16.data());
+
+		std::memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+		hdr.version = GLMesh::VERSION;
+		hdr.flags = flags;
+		hdr.index_size = static_cast<std::uint32_t>(index_size);
+		hdr.vertex_cnt = positions.size();
+		hdr.index_cnt = triangles.size();
+
+		size_t offset = align(sizeof(Header));
+		hdr.positions_offset = offset;
+		offset = align(offset + positions.size() * sizeof(glm::vec3));
+		hdr.normals_offset = offset;
+		offset = align(offset + normals.size() * sizeof(glm::vec3));
+		hdr.texcoords_offset = offset;
+		offset = align(offset + texcoords.size() * sizeof(glm::vec2));
+		hdr.triangles_offset = offset;
+		offset += triangles.size() * index_size;
+		hdr.file_size = offset;
+
+		image.assign(offset, 0);
+		std::memcpy(image.data(), &hdr, sizeof(hdr));
+		std::memcpy(image.data() + hdr.positions_offset, positions.data(), positions.size() * sizeof(glm::vec3));
+		std::memcpy(image.data() + hdr.normals_offset, normals.data(), normals.size() * sizeof(glm::vec3));
+		std::memcpy(image.data() + hdr.texcoords_offset, texcoords.data(), texcoords.size() * sizeof(glm::vec2));
+		std::memcpy(image.data() + hdr.triangles_offset, index_data, triangles.size() * index_size);
+		return true;
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMesh::load(std::string const& obj_path, std::uint32_t flags)
+
+@brief
+	This function loads the mesh of obj_path, from its cache file if the
+	cache is valid for the OBJ file and flags, otherwise by parsing the OBJ
+	file and rewriting the cache.
+
+@param obj_path
+	path of the OBJ file
+
+@param flags
+	combination of Flags
+
+@return bool
+	false if the mesh couldn't be loaded
+
+*/
+bool GLMesh::load(std::string const& obj_path, std::uint32_t flags)
+{
+	unload();
+	std::string const cache_path = obj_path + ".dpmb";
+
+	// Part 1: Identify the current OBJ file
+	Header src{};
+	if (!file_stat(obj_path, src.source_mtime, src.source_size))
+	{
+		std::cerr << "Unable to open mesh " << obj_path << std::endl;
+		return false;
+	}
+
+	// Part 2: Use the cache if it was written for this OBJ file and flags
+	Header hdr{};
+	if (read_header(cache_path, hdr) && hdr.flags == flags)
+	{
+		bool valid = hdr.source_mtime == src.source_mtime && hdr.source_size == src.source_size;
+		if (!valid && hdr.source_size == src.source_size
+			&& file_hash(obj_path, src.source_hash) && src.source_hash == hdr.source_hash)
+		{
+			// only touched: record the new time so the next load skips the
+			// hash; if that fails the cache is still valid, just slower
+			hdr.source_mtime = src.source_mtime;
+			std::vector<std::uint8_t> cache;
+			bool updated = read_file(cache_path, cache) && cache.size() >= sizeof(hdr);
+			if (updated)
+			{
+				std::memcpy(cache.data(), &hdr, sizeof(hdr));
+				updated = write_file(cache_path, cache.data(), cache.size());
+			}
+			if (!updated)
+			{
+				std::cerr << "Unable to update mesh cache " << cache_path << std::endl;
+			}
+			valid = true;
+		}
+		if (valid && map(cache_path))
+		{
+			parsed = false;
+			return true;
+		}
+	}
+
+	// Part 3: Parse the OBJ file and rewrite the cache
+	if (!file_hash(obj_path, src.source_hash) || !build_image(obj_path, flags, src, image))
+	{
+		image.clear();
+		return false;
+	}
+	parsed = true;
+
+	// an unwritten cache file may still hold an older mesh, so only a
+	// successful write is mapped
+	if (!write_file(cache_path, image.data(), image.size()))
+	{
+		std::cerr << "Unable to write mesh cache " << cache_path << std::endl;
+	}
+	else if (map(cache_path))
+	{
+		std::vector<std::uint8_t>().swap(image);
+		return true;
+	}
+
+	// Part 4: The cache file is unusable; serve the mesh from memory
+	return attach(image.data(), image.size());
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMesh::unload()
+
+@brief
+	This function releases the mapping (or in-memory image) of the mesh.
+
+@return none
+*/
+void GLMesh::unload()
+{
+	unmap();
+	std::vector<std::uint8_t>().swap(image);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMesh::unmap()
+
+@brief
+	This function releases the mapping of the cache file, if any, and
+	empties the spans, but keeps the in-memory image.
+
+@return none
+*/
+void GLMesh::unmap()
+{
+	if (map_addr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(map_addr);
+#else
+		munmap(map_addr, map_size);
+#endif
+		map_addr = nullptr;
+		map_size = 0;
+	}
+	positions = Span<glm::vec3>{};
+	normals = Span<glm::vec3>{};
+	texcoords = Span<glm::vec2>{};
+	triangles16 = Span<GLushort>{};
+	triangles32 = Span<GLuint>{};
+	index_type = GL_UNSIGNED_SHORT;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMesh::map(std::string const& cache_path)
+
+@brief
+	This function maps the whole cache file read-only and points the spans
+	into it.
+
+@return bool
+	false if the file can't be mapped or is inconsistent
+*/
+bool GLMesh::map(std::string const& cache_path)
+{
+#ifdef _WIN32
+	HANDLE const file = CreateFileA(cache_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER size{};
+	GetFileSizeEx(file, &size);
+	HANDLE const mapping = (size.QuadPart > 0)
+		? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	void* const addr = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	// the view keeps the file mapped after the handles are closed
+	if (mapping)
+	{
+		CloseHandle(mapping);
+	}
+	CloseHandle(file);
+	if (!addr)
+	{
+		return false;
+	}
+	map_size = static_cast<size_t>(size.QuadPart);
+#else
+	int const fd = open(cache_path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	void* addr = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	// the mapping stays valid after the descriptor is closed
+	close(fd);
+	if (addr == MAP_FAILED)
+	{
+		return false;
+	}
+	map_size = static_cast<size_t>(st.st_size);
+#endif
+
+	map_addr = addr;
+	if (!attach(static_cast<std::uint8_t const*>(map_addr), map_size))
+	{
+		unmap();
+		return false;
+	}
+	return true;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMesh::attach(std::uint8_t const* base, size_t size)
+
+@brief
+	This function checks that the arrays described by the header at base
+	lie within size bytes and points the spans at them.
+
+@return bool
+	false if the header is inconsistent
+*/
+bool GLMesh::attach(std::uint8_t const* base, size_t size)
+{
+	Header hdr;
+	if (size < sizeof(Header))
+	{
+		return false;
+	}
+	std::memcpy(&hdr, base, sizeof(hdr));
+
+	std::uint64_t const nml_cnt = (hdr.flags & NORMALS) ? hdr.vertex_cnt : 0;
+	std::uint64_t const tex_cnt = (hdr.flags & TEXCOORDS) ? hdr.vertex_cnt : 0;
+	if (std::memcmp(hdr.magic, MAGIC, sizeof(MAGIC)) != 0 || hdr.file_size != size
+		|| !fits(hdr.positions_offset, hdr.vertex_cnt, sizeof(glm::vec3), size)
+		|| !fits(hdr.normals_offset, nml_cnt, sizeof(glm::vec3), size)
+		|| !fits(hdr.texcoords_offset, tex_cnt, sizeof(glm::vec2), size)
+		|| (hdr.index_size != sizeof(GLushort) && hdr.index_size != sizeof(GLuint))
+		|| !fits(hdr.triangles_offset, hdr.index_cnt, hdr.index_size, size))
+	{
+		std::cerr << "Mesh cache is corrupt" << std::endl;
+		return false;
+	}
+
+	// every offset and count is now known to fit size_t
+	positions = Span<glm::vec3>{ reinterpret_cast<glm::vec3 const*>(base + hdr.positions_offset),
+		static_cast<size_t>(hdr.vertex_cnt) };
+	normals = Span<glm::vec3>{ reinterpret_cast<glm::vec3 const*>(base + hdr.normals_offset),
+		static_cast<size_t>(nml_cnt) };
+	texcoords = Span<glm::vec2>{ reinterpret_cast<glm::vec2 const*>(base + hdr.texcoords_offset),
+		static_cast<size_t>(tex_cnt) };
+	if (hdr.index_size == sizeof(GLushort))
+	{
+		index_type = GL_UNSIGNED_SHORT;
+		triangles16 = Span<GLushort>{ reinterpret_cast<GLushort const*>(base + hdr.triangles_offset),
+			static_cast<size_t>(hdr.index_cnt) };
+	}
+	else
+	{
+		index_type = GL_UNSIGNED_INT;
+		triangles32 = Span<GLuint>{ reinterpret_cast<GLuint const*>(base + hdr.triangles_offset),
+			static_cast<size_t>(hdr.index_cnt) };
+	}
+	return true;
+}
+
+size_t GLMesh::index_cnt() const
+{
+	return (index_type == GL_UNSIGNED_SHORT) ? triangles16.size() : triangles32.size();
+}
+
+size_t GLMesh::index_size() const
+{
+	return (index_type == GL_UNSIGNED_SHORT) ? sizeof(GLushort) : sizeof(GLuint);
+}
+
+void const* GLMesh::index_data() const
+{
+	return (index_type == GL_UNSIGNED_SHORT)
+		? static_cast<void const*>(triangles16.data()) : static_cast<void const*>(triangles32.data());
+}
+
+GLuint GLMesh::index(size_t i) const
+{
+	return (index_type == GL_UNSIGNED_SHORT) ? triangles16[i] : triangles32[i];
+}
+
+GLenum GLMesh::index_type_for(size_t vertex_cnt)
+{
+	return (vertex_cnt <= size_t(1) << 16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
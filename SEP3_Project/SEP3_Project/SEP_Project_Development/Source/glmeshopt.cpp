@@ -0,0 +1,394 @@
+/*!
+@file		glmeshopt.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the mesh optimization passes declared in glmeshopt.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glmeshopt.h>
+
+#include <algorithm>								// std::sort, std::find
+#include <cmath>									// std::pow, std::sqrt
+#include <iomanip>									// std::setprecision
+#include <limits>									// std::numeric_limits
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	constexpr int MAX_CACHE = static_cast<int>(GLMeshOpt::OPTIMIZE_CACHE_SIZE);
+
+	// Forsyth's scoring constants
+	constexpr float CACHE_DECAY_POWER = 1.5f;
+	constexpr float LAST_TRI_SCORE = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.0f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+	/*  _________________________________________________________________________*/
+	/*! vertex_score
+
+	@brief
+		Score of a vertex at position cache_pos of the LRU cache (-1 if not
+		cached) that is still used by remaining triangles. Vertices of the
+		last triangle get a fixed score so the next triangle doesn't simply
+		reuse all of them; other cached vertices score higher the more
+		recently they were used; vertices with few remaining triangles are
+		boosted so that they are finished off instead of leaving lone
+		triangles behind.
+
+	@return float
+	*/
+	float vertex_score(int cache_pos, unsigned remaining)
+	{
+		if (remaining == 0)
+		{
+			return -1.0f;
+		}
+
+		float score = 0.0f;
+		if (cache_pos >= 0)
+		{
+			if (cache_pos < 3)
+			{
+				score = LAST_TRI_SCORE;
+			}
+			else
+			{
+				float const scaler = 1.0f / (MAX_CACHE - 3);
+				score = std::pow(1.0f - (cache_pos - 3) * scaler, CACHE_DECAY_POWER);
+			}
+		}
+		return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMeshOpt::analyze(std::vector<GLuint> const& indices, size_t vertex_cnt, size_t cache_size)
+
+@brief
+	This function counts the vertex shader invocations of indices with a
+	FIFO post-transform cache of cache_size vertices.
+
+@return CacheStats
+	ACMR and ATVR of indices
+*/
+GLMeshOpt::CacheStats GLMeshOpt::analyze(std::vector<GLuint> const& indices, size_t vertex_cnt,
+	size_t cache_size)
+{
+	// timestamp[v] is the miss count when v entered the cache; v is cached
+	// while fewer than cache_size misses have happened since
+	std::vector<size_t> timestamp(vertex_cnt, 0);
+	size_t misses = 0;
+	for (GLuint v : indices)
+	{
+		if (timestamp[v] == 0 || misses + 1 - timestamp[v] > cache_size)
+		{
+			misses++;
+			timestamp[v] = misses;
+		}
+	}
+
+	size_t const tri_cnt = indices.size() / 3;
+	return CacheStats{
+		tri_cnt ? static_cast<float>(misses) / tri_cnt : 0.0f,
+		vertex_cnt ? static_cast<float>(misses) / vertex_cnt : 0.0f
+	};
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMeshOpt::optimize_vertex_cache(std::vector<GLuint>& indices, size_t vertex_cnt)
+
+@brief
+	This function greedily emits, one at a time, the remaining triangle
+	whose vertices have the highest total score, while simulating an LRU
+	cache of OPTIMIZE_CACHE_SIZE vertices. Only triangles of vertices that
+	were just in the cache are rescored after each step, so the pass runs
+	in time linear in the number of triangles. When no cached vertex has a
+	remaining triangle, the next triangle not emitted yet in the original
+	order is taken.
+
+@return none
+*/
+void GLMeshOpt::optimize_vertex_cache(std::vector<GLuint>& indices, size_t vertex_cnt)
+{
+	size_t const tri_cnt = indices.size() / 3;
+	if (tri_cnt == 0)
+	{
+		return;
+	}
+
+	// Part 1: vertex -> remaining triangles adjacency
+	std::vector<unsigned> remaining(vertex_cnt, 0);
+	for (GLuint v : indices)
+	{
+		remaining[v]++;
+	}
+	std::vector<size_t> adj_offset(vertex_cnt + 1, 0);
+	for (size_t v = 0; v < vertex_cnt; v++)
+	{
+		adj_offset[v + 1] = adj_offset[v] + remaining[v];
+	}
+	std::vector<GLuint> adj(indices.size());
+	{
+		std::vector<size_t> fill(adj_offset.begin(), adj_offset.end() - 1);
+		for (size_t t = 0; t < tri_cnt; t++)
+		{
+			for (size_t k = 0; k < 3; k++)
+			{
+				adj[fill[indices[t * 3 + k]]++] = static_cast<GLuint>(t);
+			}
+		}
+	}
+
+	// Part 2: initial scores
+	std::vector<int> cache_pos(vertex_cnt, -1);
+	std::vector<float> vscore(vertex_cnt);
+	for (size_t v = 0; v < vertex_cnt; v++)
+	{
+		vscore[v] = vertex_score(-1, remaining[v]);
+	}
+	std::vector<float> tscore(tri_cnt);
+	std::vector<bool> emitted(tri_cnt, false);
+	for (size_t t = 0; t < tri_cnt; t++)
+	{
+		tscore[t] = vscore[indices[t * 3]] + vscore[indices[t * 3 + 1]] + vscore[indices[t * 3 + 2]];
+	}
+
+	// Part 3: emit triangles
+	std::vector<GLuint> result;
+	result.reserve(indices.size());
+	std::vector<GLuint> cache, next_cache;
+	cache.reserve(MAX_CACHE + 3);
+	next_cache.reserve(MAX_CACHE + 3);
+
+	size_t best = 0;
+	size_t cursor = 0;
+	for (size_t n = 0; n < tri_cnt; n++)
+	{
+		if (best == std::numeric_limits<size_t>::max())
+		{
+			while (emitted[cursor])
+			{
+				cursor++;
+			}
+			best = cursor;
+		}
+
+		GLuint const tri[3] = { indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2] };
+		result.insert(result.end(), tri, tri + 3);
+		emitted[best] = true;
+
+		// remove the triangle from its vertices' adjacency
+		for (GLuint v : tri)
+		{
+			GLuint* const begin = &adj[adj_offset[v]];
+			GLuint* const end = begin + remaining[v];
+			GLuint* const it = std::find(begin, end, static_cast<GLuint>(best));
+			if (it != end)
+			{
+				*it = *(end - 1);
+				remaining[v]--;
+			}
+		}
+
+		// the triangle's vertices move to the front of the LRU cache
+		next_cache.assign(tri, tri + 3);
+		for (GLuint v : cache)
+		{
+			if (v != tri[0] && v != tri[1] && v != tri[2])
+			{
+				next_cache.push_back(v);
+			}
+		}
+		cache.swap(next_cache);
+
+		// rescore the cached (and just evicted) vertices and their triangles
+		best = std::numeric_limits<size_t>::max();
+		float best_score = -1.0f;
+		for (size_t i = 0; i < cache.size(); i++)
+		{
+			GLuint const v = cache[i];
+			cache_pos[v] = (i < static_cast<size_t>(MAX_CACHE)) ? static_cast<int>(i) : -1;
+			float const delta = vertex_score(cache_pos[v], remaining[v]) - vscore[v];
+			vscore[v] += delta;
+			for (size_t a = adj_offset[v]; a < adj_offset[v] + remaining[v]; a++)
+			{
+				GLuint const t = adj[a];
+				tscore[t] += delta;
+				if (tscore[t] > best_score)
+				{
+					best_score = tscore[t];
+					best = t;
+				}
+			}
+		}
+		if (cache.size() > static_cast<size_t>(MAX_CACHE))
+		{
+			cache.resize(MAX_CACHE);
+		}
+	}
+
+	indices.swap(result);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMeshOpt::optimize_overdraw(std::vector<GLuint>& indices, std::vector<glm::vec3> const& positions)
+
+@brief
+	This function splits the triangle order into clusters at the triangles
+	whose three vertices all miss the simulated cache, that is, where the
+	cache optimizer started over somewhere else. Reordering whole clusters
+	therefore barely changes the cache behaviour. Clusters are then sorted
+	by how far they lie along their own average normal from the mesh's
+	centroid, largest first: those are the outward-facing, outermost
+	surfaces that tend to occlude the rest.
+
+@return none
+*/
+void GLMeshOpt::optimize_overdraw(std::vector<GLuint>& indices, std::vector<glm::vec3> const& positions)
+{
+	size_t const tri_cnt = indices.size() / 3;
+	if (tri_cnt == 0)
+	{
+		return;
+	}
+
+	// Part 1: cluster boundaries
+	std::vector<size_t> cluster_begin;
+	std::vector<size_t> timestamp(positions.size(), 0);
+	size_t misses = 0;
+	for (size_t t = 0; t < tri_cnt; t++)
+	{
+		size_t tri_misses = 0;
+		for (size_t k = 0; k < 3; k++)
+		{
+			GLuint const v = indices[t * 3 + k];
+			if (timestamp[v] == 0 || misses + 1 - timestamp[v] > ANALYSIS_CACHE_SIZE)
+			{
+				misses++;
+				tri_misses++;
+				timestamp[v] = misses;
+			}
+		}
+		if (t == 0 || tri_misses == 3)
+		{
+			cluster_begin.push_back(t);
+		}
+	}
+	cluster_begin.push_back(tri_cnt);
+
+	// Part 2: sort key of each cluster
+	glm::vec3 mesh_centroid(0.0f);
+	for (glm::vec3 const& p : positions)
+	{
+		mesh_centroid += p;
+	}
+	mesh_centroid /= static_cast<float>(positions.size());
+
+	size_t const cluster_cnt = cluster_begin.size() - 1;
+	std::vector<float> key(cluster_cnt);
+	for (size_t c = 0; c < cluster_cnt; c++)
+	{
+		glm::vec3 centroid(0.0f), normal(0.0f);
+		for (size_t t = cluster_begin[c]; t < cluster_begin[c + 1]; t++)
+		{
+			glm::vec3 const& p0 = positions[indices[t * 3]];
+			glm::vec3 const& p1 = positions[indices[t * 3 + 1]];
+			glm::vec3 const& p2 = positions[indices[t * 3 + 2]];
+			centroid += p0 + p1 + p2;
+			normal += glm::cross(p1 - p0, p2 - p0);		// area weighted
+		}
+		centroid /= 3.0f * (cluster_begin[c + 1] - cluster_begin[c]);
+		float const len = glm::length(normal);
+		key[c] = (len > 0.0f) ? glm::dot(centroid - mesh_centroid, normal / len) : 0.0f;
+	}
+
+	// Part 3: emit the clusters in order of decreasing key
+	std::vector<size_t> order(cluster_cnt);
+	for (size_t c = 0; c < cluster_cnt; c++)
+	{
+		order[c] = c;
+	}
+	std::stable_sort(order.begin(), order.end(), [&key](size_t a, size_t b) { return key[a] > key[b]; });
+
+	std::vector<GLuint> result;
+	result.reserve(indices.size());
+	for (size_t c : order)
+	{
+		result.insert(result.end(), indices.begin() + cluster_begin[c] * 3, indices.begin() + cluster_begin[c + 1] * 3);
+	}
+	indices.swap(result);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMeshOpt::optimize_vertex_fetch(std::vector<GLuint>& indices, size_t vertex_cnt)
+
+@brief
+	This function renumbers the vertices in the order the triangles first
+	reference them and rewrites indices accordingly. Unreferenced vertices
+	keep their relative order after all referenced ones.
+
+@return std::vector<GLuint>
+	new index of every old vertex
+*/
+std::vector<GLuint> GLMeshOpt::optimize_vertex_fetch(std::vector<GLuint>& indices, size_t vertex_cnt)
+{
+	GLuint const unassigned = std::numeric_limits<GLuint>::max();
+	std::vector<GLuint> new_index(vertex_cnt, unassigned);
+	GLuint next = 0;
+	for (GLuint& v : indices)
+	{
+		if (new_index[v] == unassigned)
+		{
+			new_index[v] = next++;
+		}
+		v = new_index[v];
+	}
+	for (GLuint& n : new_index)
+	{
+		if (n == unassigned)
+		{
+			n = next++;
+		}
+	}
+	return new_index;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLMeshOpt::optimize(...)
+
+@brief
+	This function runs the cache, overdraw (if requested) and fetch passes
+	on a mesh, in that order, and reports their effect.
+
+@return none
+*/
+void GLMeshOpt::optimize(std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals,
+	std::vector<glm::vec2>& texcoords, std::vector<GLuint>& indices,
+	bool overdraw, std::ostream* report)
+{
+	CacheStats const before = analyze(indices, positions.size());
+
+	optimize_vertex_cache(indices, positions.size());
+	if (overdraw)
+	{
+		optimize_overdraw(indices, positions);
+	}
+	std::vector<GLuint> const new_index = optimize_vertex_fetch(indices, positions.size());
+	remap(positions, new_index);
+	remap(normals, new_index);
+	remap(texcoords, new_index);
+
+	if (report)
+	{
+		CacheStats const after = analyze(indices, positions.size());
+		*report << std::fixed << std::setprecision(3)
+			<< "Mesh optimization (" << indices.size() / 3 << " triangles, "
+			<< positions.size() << " vertices): ACMR " << before.acmr << " -> " << after.acmr
+			<< ", ATVR " << before.atvr << " -> " << after.atvr << std::endl;
+	}
+}
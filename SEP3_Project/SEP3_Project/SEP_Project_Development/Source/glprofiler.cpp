@@ -0,0 +1,318 @@
+/*!
+@file		glprofiler.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the stage profiler declared in glprofiler.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glprofiler.h>
+
+#include <array>									// std::array
+#include <cstring>									// std::strcmp
+#include <iomanip>									// std::setw
+#include <vector>									// std::vector
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+GLProfiler::FrameListener GLProfiler::frame_listener{};
+
+namespace {
+
+	// mean of the last WINDOW samples
+	struct Rolling {
+		std::array<double, GLProfiler::WINDOW> samples{};
+		size_t next = 0;
+		size_t count = 0;
+		double sum = 0.0;
+
+		void add(double v)
+		{
+			sum += v - samples[next];
+			samples[next] = v;
+			next = (next + 1) % GLProfiler::WINDOW;
+			count = (count < GLProfiler::WINDOW) ? count + 1 : count;
+		}
+
+		double mean() const
+		{
+			return count ? sum / static_cast<double>(count) : 0.0;
+		}
+	};
+
+	struct Stage {
+		char const* name;
+		Rolling cpu;
+		Rolling gpu;
+	};
+
+	// timestamp queries of one frame: a start/end pair per timed scope
+	struct FrameQueries {
+		std::array<GLuint, GLProfiler::MAX_STAGES * 2> ids{};
+		std::array<size_t, GLProfiler::MAX_STAGES> stage{};
+		size_t used = 0;
+		std::uint64_t frame = 0;
+	};
+
+	std::vector<Stage> stages;
+	std::array<FrameQueries, GLProfiler::FRAMES_IN_FLIGHT> frames;
+	GLuint frame_slot = 0;
+	std::uint64_t frame_cnt = 0;
+	GLuint dropped = 0;
+	bool initialized = false;
+
+	// GPU time of all stages of the frames collected so far
+	Rolling gpu_frame;
+
+	// index of the stage called name, registering it if it is new
+	size_t find_stage(char const* name)
+	{
+		for (size_t i = 0; i < stages.size(); i++)
+		{
+			if (stages[i].name == name || std::strcmp(stages[i].name, name) == 0)
+			{
+				return i;
+			}
+		}
+		if (stages.size() == GLProfiler::MAX_STAGES)
+		{
+			return GLProfiler::MAX_STAGES;
+		}
+		stages.push_back(Stage{ name, Rolling{}, Rolling{} });
+		return stages.size() - 1;
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! collect
+
+	@brief
+		This function reads the timestamps of one frame whose results are
+		available. GL_QUERY_RESULT_AVAILABLE of a scope's end query is
+		checked first; since timestamps complete in order, the start query is
+		then available too. Scopes whose results aren't ready are dropped.
+
+	@return none
+	*/
+	void collect(FrameQueries& fq)
+	{
+		double frame_ms = 0.0;
+		bool complete = fq.used > 0;
+
+		for (size_t q = 0; q < fq.used; q++)
+		{
+			GLuint available = GL_FALSE;
+			glGetQueryObjectuiv(fq.ids[q * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+			{
+				dropped++;
+				complete = false;
+				continue;
+			}
+
+			GLuint64 start = 0, end = 0;
+			glGetQueryObjectui64v(fq.ids[q * 2], GL_QUERY_RESULT, &start);
+			glGetQueryObjectui64v(fq.ids[q * 2 + 1], GL_QUERY_RESULT, &end);
+			double const ms = static_cast<double>(end - start) * 1e-6;
+			stages[fq.stage[q]].gpu.add(ms);
+			frame_ms += ms;
+		}
+
+		if (complete)
+		{
+			gpu_frame.add(frame_ms);
+			if (GLProfiler::frame_listener)
+			{
+				GLProfiler::frame_listener(fq.frame, frame_ms);
+			}
+		}
+		fq.used = 0;
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::Scope::Scope(char const* name, bool gpu)
+
+@brief
+	This constructor starts timing the stage called name on the CPU and, if
+	gpu is set and the frame has query objects left, on the GPU.
+
+*/
+GLProfiler::Scope::Scope(char const* name, bool gpu)
+	: stage(find_stage(name)), query(-1), start(std::chrono::steady_clock::now())
+{
+	FrameQueries& fq = frames[frame_slot];
+	if (gpu && initialized && stage < MAX_STAGES && fq.used < MAX_STAGES)
+	{
+		query = static_cast<GLint>(fq.used++);
+		fq.stage[query] = stage;
+		glQueryCounter(fq.ids[query * 2], GL_TIMESTAMP);
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::Scope::~Scope()
+
+@brief
+	This destructor stops timing the stage and adds the CPU time to its
+	rolling average. The GPU time is added when the frame is collected.
+
+*/
+GLProfiler::Scope::~Scope()
+{
+	if (query >= 0)
+	{
+		glQueryCounter(frames[frame_slot].ids[query * 2 + 1], GL_TIMESTAMP);
+	}
+	if (stage < MAX_STAGES)
+	{
+		stages[stage].cpu.add(std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::init()
+
+@brief
+	This function creates the ring of timestamp queries.
+
+@return none
+*/
+void GLProfiler::init()
+{
+	stages.clear();
+	stages.reserve(MAX_STAGES);
+	for (FrameQueries& fq : frames)
+	{
+		glGenQueries(static_cast<GLsizei>(fq.ids.size()), fq.ids.data());
+		fq.used = 0;
+		fq.frame = 0;
+	}
+	frame_slot = 0;
+	frame_cnt = 0;
+	dropped = 0;
+	gpu_frame = Rolling{};
+	initialized = true;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::cleanup()
+
+@brief
+	This function deletes the query objects.
+
+@return none
+*/
+void GLProfiler::cleanup()
+{
+	for (FrameQueries& fq : frames)
+	{
+		glDeleteQueries(static_cast<GLsizei>(fq.ids.size()), fq.ids.data());
+		fq.used = 0;
+	}
+	initialized = false;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::begin_frame()
+
+@brief
+	This function advances the ring to the next frame's query objects and
+	collects the results they hold from FRAMES_IN_FLIGHT frames ago.
+
+@return none
+*/
+void GLProfiler::begin_frame()
+{
+	if (!initialized)
+	{
+		return;
+	}
+	frame_slot = (frame_slot + 1) % FRAMES_IN_FLIGHT;
+	collect(frames[frame_slot]);
+	frames[frame_slot].frame = ++frame_cnt;
+}
+
+std::uint64_t GLProfiler::frame_number()
+{
+	return frame_cnt;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::flush()
+
+@brief
+	This function waits for the GPU, then collects the frames still in the
+	ring, oldest first, including the current one.
+
+@return none
+*/
+void GLProfiler::flush()
+{
+	if (!initialized)
+	{
+		return;
+	}
+	glFinish();
+	for (GLuint i = 1; i <= FRAMES_IN_FLIGHT; i++)
+	{
+		collect(frames[(frame_slot + i) % FRAMES_IN_FLIGHT]);
+	}
+}
+
+size_t GLProfiler::stage_count()
+{
+	return stages.size();
+}
+
+char const* GLProfiler::stage_name(size_t stage)
+{
+	return stages[stage].name;
+}
+
+double GLProfiler::cpu_ms(size_t stage)
+{
+	return stages[stage].cpu.mean();
+}
+
+double GLProfiler::gpu_ms(size_t stage)
+{
+	return stages[stage].gpu.mean();
+}
+
+double GLProfiler::gpu_frame_ms()
+{
+	return gpu_frame.mean();
+}
+
+GLuint GLProfiler::dropped_cnt()
+{
+	return dropped;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLProfiler::report(std::ostream& os)
+
+@brief
+	This function prints one line per stage with its rolling average CPU
+	and GPU times.
+
+@return none
+*/
+void GLProfiler::report(std::ostream& os)
+{
+	os << std::fixed << std::setprecision(3)
+		<< std::left << std::setw(16) << "stage"
+		<< std::right << std::setw(10) << "cpu ms" << std::setw(10) << "gpu ms" << '\n';
+	for (size_t i = 0; i < stages.size(); i++)
+	{
+		os << std::left << std::setw(16) << stages[i].name
+			<< std::right << std::setw(10) << cpu_ms(i) << std::setw(10) << gpu_ms(i) << '\n';
+	}
+	os << std::left << std::setw(16) << "gpu frame"
+		<< std::right << std::setw(10) << "" << std::setw(10) << gpu_frame_ms() << '\n'
+		<< "dropped gpu results: " << dropped << std::endl;
+}
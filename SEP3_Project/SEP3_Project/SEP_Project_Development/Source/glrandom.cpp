@@ -0,0 +1,256 @@
+/*!
+@file		glrandom.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the counter-based generator declared in glrandom.h:
+a scalar, an SSE2 and an AVX2 path of uniform_floats that draw the same
+numbers, selected with the instruction set of GLXform.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glrandom.h>
+#include <glxform.h>
+
+#include <random>									// std::random_device
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define GLRANDOM_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+// MSVC emits any intrinsic regardless of /arch, so no per-function target is needed
+#define GLRANDOM_TARGET_SSE2
+#define GLRANDOM_TARGET_AVX2
+#else
+#define GLRANDOM_TARGET_SSE2 __attribute__((target("sse2")))
+#define GLRANDOM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+std::uint64_t GLRandom::seed{ std::random_device{}() };
+
+namespace {
+
+	// multipliers of GLRandom::mix
+	constexpr std::uint64_t MIX1 = 0xBF58476D1CE4E5B9ull;
+	constexpr std::uint64_t MIX2 = 0x94D049BB133111EBull;
+
+	/*  _________________________________________________________________________*/
+	/*! uniform_floats_scalar
+
+	@brief
+		Scalar path of GLRandom::uniform_floats, writing out[begin, end) from
+		the numbers of the stream with key k starting at counter for out[0].
+		Also used for the floats left over by the SIMD paths.
+
+	@return none
+	*/
+	void uniform_floats_scalar(size_t begin, size_t end, std::uint64_t k, std::uint64_t counter,
+		GLfloat* out, GLfloat min, GLfloat scale)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			// 24 bits fit a signed int, as converted by the SIMD paths
+			std::int32_t const high = static_cast<std::int32_t>(GLRandom::bits(k, counter + i) >> 40);
+			out[i] = min + static_cast<GLfloat>(high) * scale;
+		}
+	}
+
+#ifdef GLRANDOM_X86
+	/*  _________________________________________________________________________*/
+	/*! mul64_sse2
+
+	@brief
+		This function returns the low 64 bits of the products of the 64-bit
+		lanes of a with c, from the 32x32-bit products _mm_mul_epu32 makes:
+		a * c = lo(a) * lo(c) + ((hi(a) * lo(c) + lo(a) * hi(c)) << 32).
+
+	@return __m128i
+	*/
+	GLRANDOM_TARGET_SSE2 inline __m128i mul64_sse2(__m128i a, __m128i c_lo, __m128i c_hi)
+	{
+		__m128i const cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), c_lo),
+			_mm_mul_epu32(a, c_hi));
+		return _mm_add_epi64(_mm_mul_epu32(a, c_lo), _mm_slli_epi64(cross, 32));
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! mix_sse2
+
+	@brief
+		GLRandom::mix of two 64-bit lanes.
+
+	@return __m128i
+	*/
+	GLRANDOM_TARGET_SSE2 inline __m128i mix_sse2(__m128i z)
+	{
+		z = _mm_xor_si128(z, _mm_srli_epi64(z, 30));
+		z = mul64_sse2(z, _mm_set1_epi64x(static_cast<long long>(MIX1 & 0xFFFFFFFFu)),
+			_mm_set1_epi64x(static_cast<long long>(MIX1 >> 32)));
+		z = _mm_xor_si128(z, _mm_srli_epi64(z, 27));
+		z = mul64_sse2(z, _mm_set1_epi64x(static_cast<long long>(MIX2 & 0xFFFFFFFFu)),
+			_mm_set1_epi64x(static_cast<long long>(MIX2 >> 32)));
+		return _mm_xor_si128(z, _mm_srli_epi64(z, 31));
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! uniform_floats_sse2
+
+	@brief
+		SSE2 path of GLRandom::uniform_floats, four floats per iteration from
+		two pairs of 64-bit lanes.
+
+	@return none
+	*/
+	GLRANDOM_TARGET_SSE2 void uniform_floats_sse2(size_t count, std::uint64_t k, std::uint64_t counter,
+		GLfloat* out, GLfloat min, GLfloat scale)
+	{
+		// lane l of z0 and z1 holds the input of bits() for out[i + l] and
+		// out[i + 2 + l]
+		std::uint64_t const z = k + (counter + 1) * GLRandom::GOLDEN;
+		__m128i z0 = _mm_set_epi64x(static_cast<long long>(z + GLRandom::GOLDEN), static_cast<long long>(z));
+		__m128i z1 = _mm_add_epi64(z0, _mm_set1_epi64x(static_cast<long long>(2 * GLRandom::GOLDEN)));
+		__m128i const step = _mm_set1_epi64x(static_cast<long long>(4 * GLRandom::GOLDEN));
+		__m128 const vmin = _mm_set1_ps(min);
+		__m128 const vscale = _mm_set1_ps(scale);
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i const h0 = _mm_srli_epi64(mix_sse2(z0), 40);
+			__m128i const h1 = _mm_srli_epi64(mix_sse2(z1), 40);
+			// the low 32 bits of every lane, in order
+			__m128i const high = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(h0),
+				_mm_castsi128_ps(h1), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(out + i, _mm_add_ps(vmin, _mm_mul_ps(_mm_cvtepi32_ps(high), vscale)));
+			z0 = _mm_add_epi64(z0, step);
+			z1 = _mm_add_epi64(z1, step);
+		}
+
+		uniform_floats_scalar(i, count, k, counter, out, min, scale);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! mul64_avx2, mix_avx2
+
+	@brief
+		mul64_sse2 and mix_sse2 of four 64-bit lanes.
+
+	@return __m256i
+	*/
+	GLRANDOM_TARGET_AVX2 inline __m256i mul64_avx2(__m256i a, __m256i c_lo, __m256i c_hi)
+	{
+		__m256i const cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), c_lo),
+			_mm256_mul_epu32(a, c_hi));
+		return _mm256_add_epi64(_mm256_mul_epu32(a, c_lo), _mm256_slli_epi64(cross, 32));
+	}
+
+	GLRANDOM_TARGET_AVX2 inline __m256i mix_avx2(__m256i z)
+	{
+		z = _mm256_xor_si256(z, _mm256_srli_epi64(z, 30));
+		z = mul64_avx2(z, _mm256_set1_epi64x(static_cast<long long>(MIX1 & 0xFFFFFFFFu)),
+			_mm256_set1_epi64x(static_cast<long long>(MIX1 >> 32)));
+		z = _mm256_xor_si256(z, _mm256_srli_epi64(z, 27));
+		z = mul64_avx2(z, _mm256_set1_epi64x(static_cast<long long>(MIX2 & 0xFFFFFFFFu)),
+			_mm256_set1_epi64x(static_cast<long long>(MIX2 >> 32)));
+		return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! uniform_floats_avx2
+
+	@brief
+		AVX2 path of GLRandom::uniform_floats, eight floats per iteration
+		from two sets of four 64-bit lanes.
+
+	@return none
+	*/
+	GLRANDOM_TARGET_AVX2 void uniform_floats_avx2(size_t count, std::uint64_t k, std::uint64_t counter,
+		GLfloat* out, GLfloat min, GLfloat scale)
+	{
+		std::uint64_t const z = k + (counter + 1) * GLRandom::GOLDEN;
+		__m256i z0 = _mm256_set_epi64x(static_cast<long long>(z + 3 * GLRandom::GOLDEN),
+			static_cast<long long>(z + 2 * GLRandom::GOLDEN),
+			static_cast<long long>(z + GLRandom::GOLDEN), static_cast<long long>(z));
+		__m256i z1 = _mm256_add_epi64(z0, _mm256_set1_epi64x(static_cast<long long>(4 * GLRandom::GOLDEN)));
+		__m256i const step = _mm256_set1_epi64x(static_cast<long long>(8 * GLRandom::GOLDEN));
+		// gathers the low 32 bits of the four lanes into the low half
+		__m256i const low_dwords = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+		__m256 const vmin = _mm256_set1_ps(min);
+		__m256 const vscale = _mm256_set1_ps(scale);
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i const h0 = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(mix_avx2(z0), 40), low_dwords);
+			__m256i const h1 = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(mix_avx2(z1), 40), low_dwords);
+			__m256i const high = _mm256_inserti128_si256(h0, _mm256_castsi256_si128(h1), 1);
+			_mm256_storeu_ps(out + i, _mm256_add_ps(vmin, _mm256_mul_ps(_mm256_cvtepi32_ps(high), vscale)));
+			z0 = _mm256_add_epi64(z0, step);
+			z1 = _mm256_add_epi64(z1, step);
+		}
+
+		uniform_floats_sse2(count - i, k, counter + i, out + i, min, scale);
+	}
+#endif
+}
+
+/*  _________________________________________________________________________*/
+/*! GLRandom::uniform_floats(std::uint64_t stream, std::uint64_t counter, GLfloat* out, size_t count, GLfloat min, GLfloat max)
+
+@brief
+	This function converts the high 24 bits of numbers [counter, counter +
+	count) of stream to floats in [min, max), with the instruction set
+	selected for GLXform::update; on x64 the SSE2 kernel is slower than the
+	scalar path and only finishes the AVX2 one. Every path draws the same
+	floats.
+
+@param stream
+	stream to draw from
+
+@param counter
+	number of the stream written to out[0]
+
+@param out
+	count floats to fill
+
+@param count
+	number of floats
+
+@param min
+	lower bound, included
+
+@param max
+	upper bound, excluded unless equal to min
+
+@return none
+*/
+void GLRandom::uniform_floats(std::uint64_t stream, std::uint64_t counter,
+	GLfloat* out, size_t count, GLfloat min, GLfloat max)
+{
+	std::uint64_t const k = key(stream);
+	GLfloat const scale = (max - min) / 16777216.0f;
+
+	switch (GLXform::path())
+	{
+#ifdef GLRANDOM_X86
+	case GLXform::Path::AVX2:
+		uniform_floats_avx2(count, k, counter, out, min, scale);
+		return;
+	case GLXform::Path::SSE2:
+#if !defined(_M_X64) && !defined(__x86_64__)
+		uniform_floats_sse2(count, k, counter, out, min, scale);
+		return;
+#endif
+		// x64 multiplies 64-bit integers natively, one per number, which is
+		// faster than the three 32-bit multiplies per two numbers of SSE2
+#endif
+	default:
+		uniform_floats_scalar(0, count, k, counter, out, min, scale);
+		return;
+	}
+}
@@ -0,0 +1,144 @@
+/*!
+@file		glrenderqueue.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the render queue declared in glrenderqueue.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glrenderqueue.h>
+
+#include <algorithm>								// std::copy
+#include <array>									// std::array
+#include <utility>									// std::swap
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	constexpr unsigned RADIX_BITS = 8;
+	constexpr unsigned RADIX = 1u << RADIX_BITS;
+	constexpr unsigned PASSES = 64 / RADIX_BITS;
+
+	constexpr GLRenderQueue::Key field(GLuint value, unsigned bits, unsigned shift)
+	{
+		return (static_cast<GLRenderQueue::Key>(value) & ((GLRenderQueue::Key(1) << bits) - 1)) << shift;
+	}
+
+	constexpr GLuint extract(GLRenderQueue::Key key, unsigned bits, unsigned shift)
+	{
+		return static_cast<GLuint>((key >> shift) & ((GLRenderQueue::Key(1) << bits) - 1));
+	}
+}
+
+GLRenderQueue::Key GLRenderQueue::make_key(GLuint shader, GLuint model, GLuint material, GLuint depth)
+{
+	return field(shader, SHADER_BITS, SHADER_SHIFT) | field(model, MODEL_BITS, MODEL_SHIFT) |
+		field(material, MATERIAL_BITS, MATERIAL_SHIFT) | field(depth, DEPTH_BITS, 0);
+}
+
+GLuint GLRenderQueue::shader(Key key)
+{
+	return extract(key, SHADER_BITS, SHADER_SHIFT);
+}
+
+GLuint GLRenderQueue::model(Key key)
+{
+	return extract(key, MODEL_BITS, MODEL_SHIFT);
+}
+
+GLuint GLRenderQueue::material(Key key)
+{
+	return extract(key, MATERIAL_BITS, MATERIAL_SHIFT);
+}
+
+void GLRenderQueue::reserve(size_t capacity)
+{
+	packets.reserve(capacity);
+	scratch.resize(capacity);
+	runs.reserve(capacity);
+}
+
+void GLRenderQueue::clear()
+{
+	packets.clear();
+	runs.clear();
+}
+
+/*  _________________________________________________________________________*/
+/*! GLRenderQueue::sort()
+
+@brief
+	This function sorts the packets with an LSD radix sort of one byte per
+	pass, and merges them into runs.
+	The histograms of all eight bytes are counted in a single read of the
+	keys. A pass whose byte is the same in every key wouldn't move anything
+	and is skipped; since few programs, models and materials are in use,
+	most of the high bytes are, and a frame usually costs two or three
+	passes rather than eight.
+
+@return none
+*/
+void GLRenderQueue::sort()
+{
+	size_t const n = packets.size();
+	if (scratch.size() < n)
+	{
+		scratch.resize(n);
+	}
+
+	// Part 1: Histogram of every byte of the keys
+	std::array<std::array<GLuint, RADIX>, PASSES> counts{};
+	for (Packet const& p : packets)
+	{
+		for (unsigned pass = 0; pass < PASSES; pass++)
+		{
+			counts[pass][(p.key >> (pass * RADIX_BITS)) & (RADIX - 1)]++;
+		}
+	}
+
+	// Part 2: One stable counting pass per byte, least significant first,
+	// swapping between packets and scratch
+	Packet* src = packets.data();
+	Packet* dst = scratch.data();
+	for (unsigned pass = 0; pass < PASSES && n > 1; pass++)
+	{
+		std::array<GLuint, RADIX>& count = counts[pass];
+		unsigned const shift = pass * RADIX_BITS;
+		if (count[(src[0].key >> shift) & (RADIX - 1)] == n)
+		{
+			continue;
+		}
+
+		GLuint offset = 0;
+		for (GLuint& c : count)
+		{
+			GLuint const c_old = c;
+			c = offset;
+			offset += c_old;
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			dst[count[(src[i].key >> shift) & (RADIX - 1)]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+	if (src != packets.data())
+	{
+		std::copy(src, src + n, packets.data());
+	}
+
+	// Part 3: Merge packets whose keys only differ in depth
+	for (size_t i = 0; i < n; i++)
+	{
+		Key const state = packets[i].key >> DEPTH_BITS;
+		if (runs.empty() || (runs.back().key >> DEPTH_BITS) != state)
+		{
+			runs.push_back(Run{ packets[i].key, static_cast<GLuint>(i), 0 });
+		}
+		runs.back().count++;
+	}
+}
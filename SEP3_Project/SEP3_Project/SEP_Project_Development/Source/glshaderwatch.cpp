@@ -0,0 +1,400 @@
+/*!
+@file		glshaderwatch.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the shader file watcher declared in glshaderwatch.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glshaderwatch.h>
+#include <glslshader.h>
+
+#include <algorithm>								// std::find_if
+#include <atomic>									// std::atomic
+#include <chrono>									// std::chrono::milliseconds
+#include <cstdint>									// std::int64_t
+#include <deque>									// std::deque
+#include <mutex>									// std::mutex
+#include <thread>									// std::thread
+
+#include <sys/stat.h>								// stat
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	// a watched file and the programs built from it
+	struct WatchedFile {
+		std::string path;
+		std::string dir;
+		std::string name;
+		std::vector<size_t> programs;
+		std::int64_t mtime;
+		std::uint64_t size;
+	};
+
+	std::vector<GLShaderWatch::Program> programs;
+	std::vector<WatchedFile> files;
+	std::thread watcher;
+	std::atomic<bool> stopping{ false };
+
+	// updates queued by the watcher for the render thread
+	std::mutex updates_mutex;
+	std::deque<GLShaderWatch::Update> updates;
+
+#ifdef __linux__
+	// inotify instance and the directory of each of its watches; -1 when
+	// inotify isn't available and the files are polled instead
+	int inotify_fd = -1;
+	std::vector<std::pair<int, std::string>> watch_dirs;
+#endif
+
+	bool file_stat(std::string const& path, std::int64_t& mtime, std::uint64_t& size)
+	{
+#ifdef _WIN32
+		struct _stat64 st;
+		if (_stat64(path.c_str(), &st) != 0)
+		{
+			return false;
+		}
+#else
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0)
+		{
+			return false;
+		}
+#endif
+		mtime = static_cast<std::int64_t>(st.st_mtime);
+		size = static_cast<std::uint64_t>(st.st_size);
+		return true;
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! watch_files()
+
+	@brief
+		This function rebuilds the distinct files of the programs, keeping
+		the recorded state of those already watched and recording that of
+		the others, and adds an inotify watch for every new directory.
+
+	@return none
+	*/
+	void watch_files()
+	{
+		// Part 1: every distinct file, with the programs built from it
+		std::vector<WatchedFile> watched;
+		for (size_t p = 0; p < programs.size(); p++)
+		{
+			std::vector<std::string> paths(programs[p].includes);
+			for (auto const& f : programs[p].files)
+			{
+				paths.push_back(f.second);
+			}
+			for (std::string const& path : paths)
+			{
+				auto it = watched.begin();
+				while (it != watched.end() && it->path != path)
+				{
+					++it;
+				}
+				if (it == watched.end())
+				{
+					WatchedFile file;
+					file.path = path;
+					size_t const slash = path.find_last_of("/\\");
+					file.dir = (slash == std::string::npos) ? std::string(".") : path.substr(0, slash);
+					file.name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+					file.mtime = 0;
+					file.size = 0;
+					auto const old = std::find_if(files.begin(), files.end(),
+						[&path](WatchedFile const& f) { return f.path == path; });
+					if (old != files.end())
+					{
+						file.mtime = old->mtime;
+						file.size = old->size;
+					}
+					else
+					{
+						file_stat(file.path, file.mtime, file.size);
+					}
+					watched.push_back(file);
+					it = watched.end() - 1;
+				}
+				it->programs.push_back(p);
+			}
+		}
+		files = std::move(watched);
+
+		// Part 2: one inotify watch per directory
+#ifdef __linux__
+		for (WatchedFile const& file : files)
+		{
+			bool known = false;
+			for (auto const& wd : watch_dirs)
+			{
+				known = known || wd.second == file.dir;
+			}
+			if (inotify_fd >= 0 && !known)
+			{
+				int const wd = inotify_add_watch(inotify_fd, file.dir.c_str(),
+					IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+				if (wd >= 0)
+				{
+					watch_dirs.emplace_back(wd, file.dir);
+				}
+			}
+		}
+#endif
+	}
+
+	// files included by the shader files of program, directly or not
+	std::vector<std::string> included_files(GLShaderWatch::Program const& program)
+	{
+		std::vector<std::string> includes;
+		for (auto const& f : program.files)
+		{
+			std::vector<std::string> const included = GLSLShader::IncludedFiles(f.second);
+			includes.insert(includes.end(), included.begin(), included.end());
+		}
+		return includes;
+	}
+
+	void mark(WatchedFile const& file, std::vector<bool>& dirty)
+	{
+		for (size_t p : file.programs)
+		{
+			dirty[p] = true;
+		}
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! wait_for_change(std::vector<bool>& dirty, unsigned timeout_ms)
+
+	@brief
+		This function waits up to timeout_ms for a watched file to change
+		and marks the programs built from every file that did.
+
+	@return bool
+		true if a file changed
+	*/
+	bool wait_for_change(std::vector<bool>& dirty, unsigned timeout_ms)
+	{
+#ifdef __linux__
+		if (inotify_fd >= 0)
+		{
+			pollfd pfd{ inotify_fd, POLLIN, 0 };
+			if (poll(&pfd, 1, static_cast<int>(timeout_ms)) <= 0)
+			{
+				return false;
+			}
+
+			bool changed = false;
+			alignas(inotify_event) char buf[4096];
+			ssize_t len;
+			while ((len = read(inotify_fd, buf, sizeof(buf))) > 0)
+			{
+				for (char* ptr = buf; ptr < buf + len; )
+				{
+					inotify_event const* ev = reinterpret_cast<inotify_event const*>(ptr);
+					ptr += sizeof(inotify_event) + ev->len;
+					if (ev->len == 0)
+					{
+						continue;
+					}
+					for (auto const& wd : watch_dirs)
+					{
+						if (wd.first != ev->wd)
+						{
+							continue;
+						}
+						for (WatchedFile const& file : files)
+						{
+							if (file.dir == wd.second && file.name == ev->name)
+							{
+								mark(file, dirty);
+								changed = true;
+							}
+						}
+					}
+				}
+			}
+			return changed;
+		}
+#endif
+		std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+		bool changed = false;
+		for (WatchedFile& file : files)
+		{
+			std::int64_t mtime = 0;
+			std::uint64_t size = 0;
+			// a file being replaced may briefly not exist
+			if (file_stat(file.path, mtime, size) && (mtime != file.mtime || size != file.size))
+			{
+				file.mtime = mtime;
+				file.size = size;
+				mark(file, dirty);
+				changed = true;
+			}
+		}
+		return changed;
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! queue_updates(std::vector<bool> const& dirty)
+
+	@brief
+		This function reads and preprocesses the sources of every dirty
+		program and queues them for the render thread, with the files they
+		now include. An edit may have added or dropped includes, so the
+		watched files are then refreshed.
+
+	@return none
+	*/
+	void queue_updates(std::vector<bool> const& dirty)
+	{
+		bool includes_changed = false;
+		for (size_t p = 0; p < programs.size(); p++)
+		{
+			if (!dirty[p])
+			{
+				continue;
+			}
+			GLShaderWatch::Update update;
+			update.program = p;
+			update.ok = GL_TRUE == GLSLShader::ReadSources(programs[p].files, programs[p].defines,
+				update.sources, update.log);
+			update.includes = included_files(programs[p]);
+			if (update.includes != programs[p].includes)
+			{
+				programs[p].includes = update.includes;
+				includes_changed = true;
+			}
+
+			std::lock_guard<std::mutex> lock(updates_mutex);
+			// a newer version replaces one the render thread hasn't taken yet
+			for (auto it = updates.begin(); it != updates.end(); )
+			{
+				it = (it->program == p) ? updates.erase(it) : it + 1;
+			}
+			updates.push_back(std::move(update));
+		}
+
+		if (includes_changed)
+		{
+			watch_files();
+		}
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! watch_main()
+
+	@brief
+		Entry point of the watcher thread: wait for a change, let the files
+		settle, then queue the affected programs.
+
+	@return none
+	*/
+	void watch_main()
+	{
+		while (!stopping.load(std::memory_order_acquire))
+		{
+			std::vector<bool> dirty(programs.size(), false);
+			if (!wait_for_change(dirty, GLShaderWatch::POLL_MS))
+			{
+				continue;
+			}
+			while (!stopping.load(std::memory_order_acquire) &&
+				wait_for_change(dirty, GLShaderWatch::SETTLE_MS))
+			{
+			}
+			queue_updates(dirty);
+		}
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLShaderWatch::start(std::vector<Program> const& watched)
+
+@brief
+	This function collects the distinct files of the programs, records
+	their current state and starts the watcher thread.
+
+@param watched
+	programs to watch
+
+@return none
+*/
+void GLShaderWatch::start(std::vector<Program> const& watched)
+{
+	GLShaderWatch::stop();
+	programs = watched;
+	files.clear();
+
+	// Part 1: the distinct files of the programs and their directories
+#ifdef __linux__
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	watch_dirs.clear();
+#endif
+	watch_files();
+
+	// Part 2: start the thread
+	stopping = false;
+	watcher = std::thread(watch_main);
+}
+
+/*  _________________________________________________________________________*/
+/*! GLShaderWatch::stop()
+
+@brief
+	This function stops and joins the watcher thread, which notices within
+	POLL_MS, and drops the updates still queued.
+
+@return none
+*/
+void GLShaderWatch::stop()
+{
+	if (!watcher.joinable())
+	{
+		return;
+	}
+	stopping = true;
+	watcher.join();
+#ifdef __linux__
+	if (inotify_fd >= 0)
+	{
+		close(inotify_fd);
+		inotify_fd = -1;
+	}
+#endif
+	std::lock_guard<std::mutex> lock(updates_mutex);
+	updates.clear();
+}
+
+/*  _________________________________________________________________________*/
+/*! GLShaderWatch::pop(Update& update)
+
+@brief
+	This function moves the oldest queued update to update.
+
+@return bool
+	false if no update was queued
+*/
+bool GLShaderWatch::pop(Update& update)
+{
+	std::lock_guard<std::mutex> lock(updates_mutex);
+	if (updates.empty())
+	{
+		return false;
+	}
+	update = std::move(updates.front());
+	updates.pop_front();
+	return true;
+}
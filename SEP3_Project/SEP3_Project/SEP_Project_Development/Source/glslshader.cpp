@@ -13,13 +13,240 @@ Please see the class declaration for information about these functions.
 
 *//*__________________________________________________________________________*/
 #include <glslshader.h>
+#include <glstate.h>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// #include "file" directives are expanded by stb_include, with GLSL #line
+// directives that number the included files as source strings 1, 2, ...
+#define STB_INCLUDE_IMPLEMENTATION
+#define STB_INCLUDE_LINE_GLSL
+#include <stb_include.h>
+
+// program binaries are saved in a directory of their own, created by the
+// first save, rather than among the shader sources
+std::string GLSLShader::binary_cache_dir{ "../cache/shaders/" };
+
+// header of a program binary cache file, followed by the binary itself
+struct BinaryHeader {
+  uint32_t magic;     // "GLPB"
+  uint32_t version;   // BINARY_VERSION of the layout
+  uint32_t format;    // binary format of the driver
+  uint32_t padding;
+  uint64_t driver;    // DriverHash() of the driver that produced the binary
+};
+static uint32_t const BINARY_MAGIC = 0x42504C47;
+static uint32_t const BINARY_VERSION = 2;
+static char const BINARY_EXTENSION[] = ".glpb";
+
+// 64-bit FNV-1a hash of size bytes at data, continuing from hash
+static uint64_t HashBytes(void const* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+  unsigned char const* bytes = static_cast<unsigned char const*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// hash of the driver's vendor, renderer and version strings; a program
+// binary is only valid for the driver that produced it
+static uint64_t DriverHash() {
+  uint64_t hash = HashBytes(nullptr, 0); // the FNV-1a offset basis
+  GLenum const driver_strings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+  for (GLenum name : driver_strings) {
+    GLchar const* str = reinterpret_cast<GLchar const*>(glGetString(name));
+    std::string const value = str ? str : "";
+    hash = HashBytes(value.c_str(), value.size() + 1, hash);
+  }
+  return hash;
+}
+
+// create the missing directories of path, a directory ending with a
+// separator; failures show when a file in it can't be written
+static void CreateDirectories(std::string const& path) {
+  for (size_t pos = path.find_first_of("/\\"); pos != std::string::npos;
+       pos = path.find_first_of("/\\", pos + 1)) {
+    std::string const dir = path.substr(0, pos);
+    if (dir.empty() || dir == "." || dir == "..") {
+      continue;
+    }
+#ifdef _WIN32
+    CreateDirectoryA(dir.c_str(), NULL);
+#else
+    mkdir(dir.c_str(), 0755);
+#endif
+  }
+}
+
+// names of the files of directory dir, ending with a separator or empty
+// for the working directory, whose names end with extension
+static std::vector<std::string> ListFiles(std::string const& dir, std::string const& extension) {
+  std::vector<std::string> names;
+  auto const add = [&](std::string const& name) {
+    if (name.size() > extension.size() &&
+        name.compare(name.size() - extension.size(), extension.size(), extension) == 0) {
+      names.push_back(name);
+    }
+  };
+#ifdef _WIN32
+  WIN32_FIND_DATAA data;
+  HANDLE const find = FindFirstFileA((dir + "*" + extension).c_str(), &data);
+  if (find != INVALID_HANDLE_VALUE) {
+    do {
+      add(data.cFileName);
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+  }
+#else
+  if (DIR* const d = opendir(dir.empty() ? "." : dir.c_str())) {
+    while (dirent const* const entry = readdir(d)) {
+      add(entry->d_name);
+    }
+    closedir(d);
+  }
+#endif
+  return names;
+}
+
+// true if the driver compiles and links in the background and reports
+// progress with GL_COMPLETION_STATUS_KHR; the first call also lets it use
+// as many compiler threads as it likes
+static bool ParallelCompile() {
+  static bool const parallel = [] {
+    if (GLEW_KHR_parallel_shader_compile) {
+      glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+      return true;
+    }
+    if (GLEW_ARB_parallel_shader_compile) {
+      glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+      return true;
+    }
+    return false;
+  }();
+  return parallel;
+}
+
+// directory of the file at path, where the files it includes are looked up
+static std::string DirectoryOf(std::string const& path) {
+  size_t const slash = path.find_last_of("/\\");
+  return (slash == std::string::npos) ? std::string(".") : path.substr(0, slash);
+}
+
+// insert a #define for each name of defines after the #version directive
+// of src, which must stay the first statement; a #line directive keeps the
+// compiler's line numbers matching the file
+static std::string InjectDefines(std::string const& src, std::vector<std::string> const& defines) {
+  if (defines.empty()) {
+    return src;
+  }
+  size_t pos = 0;
+  size_t const version = src.find("#version");
+  if (version != std::string::npos) {
+    pos = src.find('\n', version);
+    pos = (pos == std::string::npos) ? src.size() : pos + 1;
+  }
+  std::string block;
+  for (std::string const& name : defines) {
+    block += "#define " + name + "\n";
+  }
+  long const next_line = 1 + static_cast<long>(std::count(src.begin(), src.begin() + pos, '\n'));
+  block += "#line " + std::to_string(next_line) + "\n";
+  return src.substr(0, pos) + block + src.substr(pos);
+}
+
+// return true for sampler and image types, which are neither scalars,
+// vectors nor matrices and whose values are set with glUniform1i
+static bool IsOpaqueType(GLenum type) {
+  switch (type) {
+  case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+  case GL_DOUBLE: case GL_DOUBLE_VEC2: case GL_DOUBLE_VEC3: case GL_DOUBLE_VEC4:
+  case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+  case GL_UNSIGNED_INT: case GL_UNSIGNED_INT_VEC2: case GL_UNSIGNED_INT_VEC3: case GL_UNSIGNED_INT_VEC4:
+  case GL_BOOL: case GL_BOOL_VEC2: case GL_BOOL_VEC3: case GL_BOOL_VEC4:
+  case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+  case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT2x4: case GL_FLOAT_MAT3x2:
+  case GL_FLOAT_MAT3x4: case GL_FLOAT_MAT4x2: case GL_FLOAT_MAT4x3:
+    return false;
+  default:
+    return true;
+  }
+}
 
 GLint
 GLSLShader::GetUniformLocation(GLchar const* name) {
-  return glGetUniformLocation(pgm_handle, name);
+  auto const it = uniforms.find(name);
+  if (it != uniforms.end()) {
+    return it->second.loc;
+  }
+  if (missing_uniforms.insert(name).second) {
+    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
+  }
+  return -1;
+}
+
+void
+GLSLShader::ReflectUniforms() {
+  uniforms.clear();
+  missing_uniforms.clear();
+
+  GLint max_length, num_uniforms;
+  glGetProgramiv(pgm_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+  glGetProgramiv(pgm_handle, GL_ACTIVE_UNIFORMS, &num_uniforms);
+  if (num_uniforms <= 0) {
+    return;
+  }
+  std::vector<GLchar> pname(max_length);
+  for (GLint i = 0; i < num_uniforms; ++i) {
+    GLsizei written;
+    GLint size;
+    GLenum type;
+    glGetActiveUniform(pgm_handle, i, max_length, &written, &size, &type, pname.data());
+    std::string name(pname.data(), written);
+    GLint loc = glGetUniformLocation(pgm_handle, name.c_str());
+    if (loc < 0) {
+      continue; // uniform block members have no location
+    }
+    // arrays are reported as "name[0]" but may be looked up as "name"
+    if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+      uniforms[name.substr(0, name.size() - 3)] = UniformInfo{ loc, type };
+    }
+    uniforms[name] = UniformInfo{ loc, type };
+  }
+}
+
+GLint
+GLSLShader::ResolveUniform(GLchar const* name, GLenum type) {
+  GLint loc = GetUniformLocation(name);
+  if (loc < 0) {
+    return -1;
+  }
+  GLenum const actual = uniforms.find(name)->second.type;
+  // samplers and images are set as GLint
+  bool const matches = (actual == type) || (type == GL_INT && IsOpaqueType(actual));
+  if (!matches) {
+    if (missing_uniforms.insert(name).second) {
+      std::cout << "Uniform variable " << name << " has a different type" << std::endl;
+    }
+    return -1;
+  }
+  return loc;
 }
 
 GLboolean
@@ -31,51 +258,384 @@ void
 GLSLShader::DeleteShaderProgram() {
   if (pgm_handle > 0) {
     glDeleteProgram(pgm_handle);
+    // the name may be reused by a new program that GLState would then
+    // believe is already installed
+    GLState::invalidate();
   }
 }
 
 GLboolean
-GLSLShader::CompileLinkValidate(std::vector<std::pair<GLenum, std::string>> vec) {
-  for (auto& elem : vec) {
-    if (GL_FALSE == CompileShaderFromFile(elem.first, elem.second.c_str())) {
-      return GL_FALSE;
+GLSLShader::ReadShaderFile(std::string const& file_name, std::string& src, std::string& log) {
+  std::ifstream shader_file(file_name, std::ifstream::in);
+  if (!shader_file) {
+    log = "Error opening file " + file_name;
+    return GL_FALSE;
+  }
+  std::stringstream buffer;
+  buffer << shader_file.rdbuf();
+
+  // stb_include takes non-const strings
+  std::string const text = buffer.str();
+  std::vector<char> str(text.begin(), text.end());
+  str.push_back('\0');
+  std::string const dir = DirectoryOf(file_name);
+  std::vector<char> path(dir.begin(), dir.end());
+  path.push_back('\0');
+  std::vector<char> name(file_name.begin(), file_name.end());
+  name.push_back('\0');
+  char error[256] = "";
+  char* const expanded = stb_include_string(str.data(), NULL, path.data(), name.data(), error);
+  if (expanded == NULL) {
+    log = std::string("Error including a file in ") + file_name + ": " + error;
+    return GL_FALSE;
+  }
+  src = expanded;
+  std::free(expanded);
+  return GL_TRUE;
+}
+
+std::vector<std::string>
+GLSLShader::IncludedFiles(std::string const& file_name) {
+  // included files are looked up in the directory of the top-level file,
+  // whatever file includes them
+  std::string const dir = DirectoryOf(file_name);
+  std::vector<std::string> included;
+  std::vector<std::string> pending{ file_name };
+  while (!pending.empty()) {
+    std::ifstream file(pending.back());
+    pending.pop_back();
+    std::string line;
+    while (std::getline(file, line)) {
+      size_t pos = line.find_first_not_of(" \t");
+      if (pos == std::string::npos || line[pos] != '#') {
+        continue;
+      }
+      pos = line.find_first_not_of(" \t", pos + 1);
+      if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) {
+        continue;
+      }
+      size_t const open = line.find('"', pos + 7);
+      size_t const close = (open == std::string::npos) ? open : line.find('"', open + 1);
+      if (close == std::string::npos) {
+        continue;
+      }
+      std::string const path = dir + "/" + line.substr(open + 1, close - open - 1);
+      if (std::find(included.begin(), included.end(), path) == included.end()) {
+        included.push_back(path);
+        pending.push_back(path);
+      }
     }
   }
-  if (GL_FALSE == Link()) {
+  return included;
+}
+
+std::vector<std::string>
+GLSLShader::PermutationDefines(Permutation key) {
+  static char const* const names[] = { "INSTANCED", "QUANTIZED_POS" };
+  std::vector<std::string> defines;
+  for (unsigned bit = 0; bit < sizeof(names) / sizeof(names[0]); ++bit) {
+    if (key & (1u << bit)) {
+      defines.push_back(names[bit]);
+    }
+  }
+  return defines;
+}
+
+std::string
+GLSLShader::BinaryCachePath(std::vector<std::pair<GLenum, std::string>> const& sources) {
+  uint64_t hash = HashBytes(&BINARY_VERSION, sizeof(BINARY_VERSION));
+  uint64_t const driver = DriverHash();
+  hash = HashBytes(&driver, sizeof(driver), hash);
+  for (auto const& src : sources) {
+    hash = HashBytes(&src.first, sizeof(src.first), hash);
+    hash = HashBytes(src.second.c_str(), src.second.size() + 1, hash);
+  }
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(hash), BINARY_EXTENSION);
+  return binary_cache_dir + name;
+}
+
+GLboolean
+GLSLShader::LoadProgramBinary(std::string const& path) {
+  std::ifstream file(path, std::ifstream::binary);
+  if (!file) {
     return GL_FALSE;
   }
-  if (GL_FALSE == Validate()) {
+  BinaryHeader header;
+  std::vector<char> binary;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != BINARY_MAGIC || header.version != BINARY_VERSION) {
+    return GL_FALSE;
+  }
+  binary.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  if (binary.empty()) {
     return GL_FALSE;
   }
-  PrintActiveAttribs();
-  PrintActiveUniforms();
 
+  // a driver update may reject binaries it produced before
+  GLuint const handle = glCreateProgram();
+  glProgramBinary(handle, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+  GLint lnk_status;
+  glGetProgramiv(handle, GL_LINK_STATUS, &lnk_status);
+  if (GL_FALSE == lnk_status) {
+    glDeleteProgram(handle);
+    return GL_FALSE;
+  }
+  pgm_handle = handle;
+  is_linked = GL_TRUE;
+  ReflectUniforms();
   return GL_TRUE;
 }
 
+void
+GLSLShader::SaveProgramBinary(std::string const& path) const {
+  GLint length = 0;
+  glGetProgramiv(pgm_handle, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  std::vector<char> binary(length);
+  GLenum format;
+  glGetProgramBinary(pgm_handle, length, &length, &format, binary.data());
+
+  // written under a temporary name so that an interrupted save never
+  // leaves a truncated binary behind; a failure only costs the next start
+  CreateDirectories(binary_cache_dir);
+  std::string const tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ofstream::binary | std::ofstream::trunc);
+    BinaryHeader const header = { BINARY_MAGIC, BINARY_VERSION, format, 0, DriverHash() };
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(binary.data(), length);
+    if (!file) {
+      file.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  std::remove(path.c_str());
+  std::rename(tmp_path.c_str(), path.c_str());
+}
+
+void
+GLSLShader::PruneBinaryCache() {
+  // once per run: the driver can't change while it runs
+  static bool pruned = false;
+  if (pruned) {
+    return;
+  }
+  pruned = true;
+
+  uint64_t const driver = DriverHash();
+  for (std::string const& name : ListFiles(binary_cache_dir, BINARY_EXTENSION)) {
+    std::string const path = binary_cache_dir + name;
+    BinaryHeader header;
+    bool current = false;
+    {
+      std::ifstream file(path, std::ifstream::binary);
+      current = file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        header.magic == BINARY_MAGIC && header.version == BINARY_VERSION && header.driver == driver;
+    }
+    if (!current) {
+      std::remove(path.c_str());
+    }
+  }
+}
+
 GLboolean
-GLSLShader::CompileShaderFromFile(GLenum shader_type, const std::string& file_name) {
-  if (GL_FALSE == FileExists(file_name)) {
-    log_string = "File not found";
+GLSLShader::ReadSources(std::vector<std::pair<GLenum, std::string>> const& files,
+                        std::vector<std::string> const& defines,
+                        std::vector<std::pair<GLenum, std::string>>& sources, std::string& log) {
+  sources.clear();
+  for (auto const& elem : files) {
+    std::string src;
+    if (GL_FALSE == ReadShaderFile(elem.second, src, log)) {
+      return GL_FALSE;
+    }
+    sources.emplace_back(elem.first, InjectDefines(src, defines));
+  }
+  return GL_TRUE;
+}
+
+GLboolean
+GLSLShader::StartBuild(std::vector<std::pair<GLenum, std::string>> const& sources) {
+  ParallelCompile();
+
+  // drivers without any binary format can't save programs
+  GLint binary_formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats);
+  pending_cache_path = (!binary_cache_dir.empty() && binary_formats > 0)
+    ? BinaryCachePath(sources) : std::string();
+
+  if (!pending_cache_path.empty() && GL_TRUE == LoadProgramBinary(pending_cache_path)) {
+    std::cout << "Loaded program binary " << pending_cache_path << std::endl;
+    pending_cache_path.clear();
+    return GL_TRUE;
+  }
+
+  pgm_handle = glCreateProgram();
+  if (0 == pgm_handle) {
+    log_string = "Cannot create program handle";
     return GL_FALSE;
   }
-  if (pgm_handle <= 0) {
-    pgm_handle = glCreateProgram();
-    if (0 == pgm_handle) {
-      log_string = "Cannot create program handle";
+  for (auto const& src : sources) {
+    switch (src.first) {
+    case VERTEX_SHADER: case FRAGMENT_SHADER: case GEOMETRY_SHADER:
+    case TESS_CONTROL_SHADER: case TESS_EVALUATION_SHADER: case COMPUTE_SHADER:
+      break;
+    default:
+      // nothing else owns the program yet, so a failed reload would leak it
+      log_string = "Incorrect shader type";
+      DeletePendingShaders();
+      glDeleteProgram(pgm_handle);
+      pgm_handle = 0;
+      pending_cache_path.clear();
       return GL_FALSE;
     }
+    GLuint const shader_handle = glCreateShader(src.first);
+    GLchar const* shader_code[] = { src.second.c_str() };
+    glShaderSource(shader_handle, 1, shader_code, NULL);
+    glCompileShader(shader_handle);
+    glAttachShader(pgm_handle, shader_handle);
+    pending_shaders.push_back(shader_handle);
+  }
+  if (!pending_cache_path.empty()) {
+    glProgramParameteri(pgm_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   }
+  glLinkProgram(pgm_handle);
+  return GL_TRUE;
+}
 
-  std::ifstream shader_file(file_name, std::ifstream::in);
-  if (!shader_file) {
-    log_string = "Error opening file " + file_name;
+GLboolean
+GLSLShader::IsBuildComplete() const {
+  if (GL_TRUE == is_linked || pgm_handle <= 0 || !ParallelCompile()) {
+    return GL_TRUE;
+  }
+  // the program completes after all its shaders
+  GLint done = GL_TRUE;
+  glGetProgramiv(pgm_handle, GL_COMPLETION_STATUS_KHR, &done);
+  return done == GL_FALSE ? GL_FALSE : GL_TRUE;
+}
+
+GLboolean
+GLSLShader::FinishBuilds(std::vector<GLSLShader*> const& shaders) {
+  GLboolean all_ok = GL_TRUE;
+  std::vector<GLSLShader*> pending(shaders);
+  while (!pending.empty()) {
+    // finish the builds in the order they complete, not in submission order
+    auto const complete = std::stable_partition(pending.begin(), pending.end(),
+      [](GLSLShader* shdr) { return GL_FALSE == shdr->IsBuildComplete(); });
+    if (complete == pending.end()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    for (auto it = complete; it != pending.end(); ++it) {
+      GLSLShader& shdr = **it;
+      if (GL_FALSE == shdr.FinishBuild() || GL_FALSE == shdr.Validate()) {
+        all_ok = GL_FALSE;
+        continue;
+      }
+      shdr.PrintActiveAttribs();
+      shdr.PrintActiveUniforms();
+    }
+    pending.erase(complete, pending.end());
+  }
+  return all_ok;
+}
+
+GLboolean
+GLSLShader::FinishBuild() {
+  if (GL_TRUE == is_linked) {
+    return GL_TRUE; // reloaded from its binary
+  }
+  if (pgm_handle <= 0) {
     return GL_FALSE;
   }
-  std::stringstream buffer;
-  buffer << shader_file.rdbuf();
-  shader_file.close();
-  return CompileShaderFromString(shader_type, buffer.str());
+
+  // a failed link is explained by the first shader that didn't compile
+  GLboolean ok = GL_TRUE;
+  for (GLuint shader_handle : pending_shaders) {
+    GLint comp_result;
+    glGetShaderiv(shader_handle, GL_COMPILE_STATUS, &comp_result);
+    if (ok && GL_FALSE == comp_result) {
+      log_string = "Shader compilation failed\n";
+      GLint log_len;
+      glGetShaderiv(shader_handle, GL_INFO_LOG_LENGTH, &log_len);
+      if (log_len > 0) {
+        std::vector<GLchar> log(log_len);
+        glGetShaderInfoLog(shader_handle, log_len, NULL, log.data());
+        log_string += log.data();
+      }
+      ok = GL_FALSE;
+    }
+  }
+
+  GLint lnk_status;
+  glGetProgramiv(pgm_handle, GL_LINK_STATUS, &lnk_status);
+  if (ok && GL_FALSE == lnk_status) {
+    log_string = "Failed to link shader program\n";
+    GLint log_len;
+    glGetProgramiv(pgm_handle, GL_INFO_LOG_LENGTH, &log_len);
+    if (log_len > 0) {
+      std::vector<GLchar> log(log_len);
+      glGetProgramInfoLog(pgm_handle, log_len, NULL, log.data());
+      log_string += log.data();
+    }
+    ok = GL_FALSE;
+  }
+
+  // the linked program doesn't need its shader objects any more
+  DeletePendingShaders();
+  if (GL_FALSE == ok || GL_FALSE == lnk_status) {
+    return GL_FALSE;
+  }
+
+  is_linked = GL_TRUE;
+  ReflectUniforms();
+  if (!pending_cache_path.empty()) {
+    SaveProgramBinary(pending_cache_path);
+    pending_cache_path.clear();
+    PruneBinaryCache();
+  }
+  return GL_TRUE;
+}
+
+void
+GLSLShader::DeletePendingShaders() {
+  for (GLuint shader_handle : pending_shaders) {
+    glDetachShader(pgm_handle, shader_handle);
+    glDeleteShader(shader_handle);
+  }
+  pending_shaders.clear();
+}
+
+GLboolean
+GLSLShader::CompileLinkValidate(std::vector<std::pair<GLenum, std::string>> vec,
+                                std::vector<std::string> const& defines) {
+  // the sources are read up front since the cache is keyed on their text
+  std::vector<std::pair<GLenum, std::string>> sources;
+  if (GL_FALSE == ReadSources(vec, defines, sources, log_string)) {
+    return GL_FALSE;
+  }
+  if (GL_FALSE == StartBuild(sources) || GL_FALSE == FinishBuild()) {
+    return GL_FALSE;
+  }
+  if (GL_FALSE == Validate()) {
+    return GL_FALSE;
+  }
+  PrintActiveAttribs();
+  PrintActiveUniforms();
+
+  return GL_TRUE;
+}
+
+GLboolean
+GLSLShader::CompileShaderFromFile(GLenum shader_type, const std::string& file_name) {
+  std::string src;
+  if (GL_FALSE == ReadShaderFile(file_name, src, log_string)) {
+    return GL_FALSE;
+  }
+  return CompileShaderFromString(shader_type, src);
 }
 
 GLboolean
@@ -96,7 +656,7 @@ GLSLShader::CompileShaderFromString(GLenum shader_type,
   case GEOMETRY_SHADER: shader_handle = glCreateShader(GL_GEOMETRY_SHADER); break;
   case TESS_CONTROL_SHADER: shader_handle = glCreateShader(GL_TESS_CONTROL_SHADER); break;
   case TESS_EVALUATION_SHADER: shader_handle = glCreateShader(GL_TESS_EVALUATION_SHADER); break;
-    //case COMPUTE_SHADER: shader_handle = glCreateShader(GL_COMPUTE_SHADER); break;
+  case COMPUTE_SHADER: shader_handle = glCreateShader(GL_COMPUTE_SHADER); break;
   default:
     log_string = "Incorrect shader type";
     return GL_FALSE;
@@ -156,17 +716,19 @@ GLboolean GLSLShader::Link() {
     }
     return GL_FALSE;
   }
-  return is_linked = GL_TRUE;
+  is_linked = GL_TRUE;
+  ReflectUniforms();
+  return GL_TRUE;
 }
 
 void GLSLShader::Use() {
   if (pgm_handle > 0 && is_linked == GL_TRUE) {
-    glUseProgram(pgm_handle);
+    GLState::use_program(pgm_handle);
   }
 }
 
 void GLSLShader::UnUse() {
-  glUseProgram(0);
+  GLState::use_program(0);
 }
 
 GLboolean GLSLShader::Validate() {
@@ -215,102 +777,128 @@ void GLSLShader::BindFragDataLocation(GLuint color_number, GLchar const* name) {
 }
 
 void GLSLShader::SetUniform(GLchar const* name, GLboolean val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform1i(loc, val);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, GLint val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform1i(loc, val);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, GLfloat val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform1f(loc, val);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform2f(loc, x, y);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y, GLfloat z) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform3f(loc, x, y, z);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void
 GLSLShader::SetUniform(GLchar const* name, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform4f(loc, x, y, z, w);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, glm::vec2 const& val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform2f(loc, val.x, val.y);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, glm::vec3 const& val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform3f(loc, val.x, val.y, val.z);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, glm::vec4 const& val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniform4f(loc, val.x, val.y, val.z, val.w);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, glm::mat3 const& val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniformMatrix3fv(loc, 1, GL_FALSE, &val[0][0]);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
   }
 }
 
 void GLSLShader::SetUniform(GLchar const* name, glm::mat4 const& val) {
-  GLint loc = glGetUniformLocation(pgm_handle, name);
+  GLint loc = GetUniformLocation(name);
   if (loc >= 0) {
     glUniformMatrix4fv(loc, 1, GL_FALSE, &val[0][0]);
-  } else {
-    std::cout << "Uniform variable " << name << " doesn't exist" << std::endl;
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<GLboolean> u, GLboolean val) {
+  if (u.IsValid()) {
+    glUniform1i(u.loc, val);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<GLint> u, GLint val) {
+  if (u.IsValid()) {
+    glUniform1i(u.loc, val);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<GLfloat> u, GLfloat val) {
+  if (u.IsValid()) {
+    glUniform1f(u.loc, val);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<glm::vec2> u, glm::vec2 const& val) {
+  if (u.IsValid()) {
+    glUniform2f(u.loc, val.x, val.y);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<glm::vec3> u, glm::vec3 const& val) {
+  if (u.IsValid()) {
+    glUniform3f(u.loc, val.x, val.y, val.z);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<glm::vec4> u, glm::vec4 const& val) {
+  if (u.IsValid()) {
+    glUniform4f(u.loc, val.x, val.y, val.z, val.w);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<glm::mat3> u, glm::mat3 const& val) {
+  if (u.IsValid()) {
+    glUniformMatrix3fv(u.loc, 1, GL_FALSE, &val[0][0]);
+  }
+}
+
+void GLSLShader::SetUniform(Uniform<glm::mat4> u, glm::mat4 const& val) {
+  if (u.IsValid()) {
+    glUniformMatrix4fv(u.loc, 1, GL_FALSE, &val[0][0]);
   }
 }
 
@@ -0,0 +1,138 @@
+/*!
+@file		glstate.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the render-state cache declared in glstate.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glstate.h>
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+unsigned GLState::issued{};
+unsigned GLState::elided{};
+unsigned GLState::issued_last{};
+unsigned GLState::elided_last{};
+
+namespace {
+
+	// value of a shadow that doesn't match anything, so the next call is
+	// issued; no object name, enum or size used by the application is this
+	GLuint const UNKNOWN = ~0u;
+
+	GLenum const buffer_targets[GLState::BUFFER_TARGET_CNT] = {
+		GL_ARRAY_BUFFER, GL_DRAW_INDIRECT_BUFFER, GL_DISPATCH_INDIRECT_BUFFER
+	};
+
+	// shadow copy of the state
+	GLuint program = UNKNOWN;
+	GLuint vertex_array = UNKNOWN;
+	GLuint buffers[GLState::BUFFER_TARGET_CNT] = { UNKNOWN, UNKNOWN, UNKNOWN };
+	GLenum polygon = UNKNOWN;
+	GLfloat line = -1.0f;
+	GLfloat point = -1.0f;
+
+	// update shadow to value; true if the call must be issued
+	template <typename T>
+	bool changes(T& shadow, T value)
+	{
+		if (shadow == value)
+		{
+			GLState::elided++;
+			return false;
+		}
+		shadow = value;
+		GLState::issued++;
+		return true;
+	}
+}
+
+void GLState::use_program(GLuint pgm_handle)
+{
+	if (changes(program, pgm_handle))
+	{
+		glUseProgram(pgm_handle);
+	}
+}
+
+void GLState::bind_vertex_array(GLuint vaoid)
+{
+	if (changes(vertex_array, vaoid))
+	{
+		glBindVertexArray(vaoid);
+	}
+}
+
+void GLState::bind_buffer(BufferTarget target, GLuint buffer)
+{
+	if (changes(buffers[target], buffer))
+	{
+		glBindBuffer(buffer_targets[target], buffer);
+	}
+}
+
+void GLState::polygon_mode(GLenum mode)
+{
+	if (changes(polygon, mode))
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, mode);
+	}
+}
+
+void GLState::line_width(GLfloat width)
+{
+	if (changes(line, width))
+	{
+		glLineWidth(width);
+	}
+}
+
+void GLState::point_size(GLfloat size)
+{
+	if (changes(point, size))
+	{
+		glPointSize(size);
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLState::invalidate()
+
+@brief
+	This function resets the shadow copy to values that match nothing.
+
+@return none
+*/
+void GLState::invalidate()
+{
+	program = UNKNOWN;
+	vertex_array = UNKNOWN;
+	for (GLuint& buffer : buffers)
+	{
+		buffer = UNKNOWN;
+	}
+	polygon = UNKNOWN;
+	line = -1.0f;
+	point = -1.0f;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLState::begin_frame()
+
+@brief
+	This function keeps the counts of the frame that ended and restarts
+	counting.
+
+@return none
+*/
+void GLState::begin_frame()
+{
+	issued_last = issued;
+	elided_last = elided;
+	issued = 0;
+	elided = 0;
+}
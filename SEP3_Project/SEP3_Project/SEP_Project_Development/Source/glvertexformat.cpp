@@ -0,0 +1,248 @@
+/*!
+@file		glvertexformat.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the vertex format descriptor declared in
+glvertexformat.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glvertexformat.h>
+
+#include <glm/gtc/packing.hpp>						// glm::packSnorm1x16, glm::packHalf1x16
+#include <algorithm>								// std::max
+#include <cstring>									// std::memcpy
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	// write value at offset of vertex vtx
+	template <typename T>
+	void put(std::vector<GLubyte>& buf, size_t vtx, GLsizei stride, GLuint offset, T const& value)
+	{
+		std::memcpy(&buf[vtx * stride + offset], &value, sizeof(T));
+	}
+
+	GLubyte unorm8(float v)
+	{
+		return static_cast<GLubyte>(glm::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	GLuint type_size(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_FLOAT:			return 4;
+		case GL_SHORT:			return 2;
+		case GL_HALF_FLOAT:		return 2;
+		case GL_UNSIGNED_BYTE:	return 1;
+		default:				return 0;
+		}
+	}
+}
+
+GLVertexFormat::GLVertexFormat()
+	: elements{}, stride(0), quantized(false), pos_decode(1.0f, 1.0f, 0.0f, 0.0f)
+{
+}
+
+/*  _________________________________________________________________________*/
+/*! GLVertexFormat::make(bool quantized, bool normals, bool texcoords)
+
+@brief
+	This function computes the interleaved layout, in the order position,
+	color, normal, texcoord, with every element 4-byte aligned.
+
+@return GLVertexFormat
+*/
+GLVertexFormat GLVertexFormat::make(bool quantized, bool normals, bool texcoords)
+{
+	GLVertexFormat fmt;
+	fmt.quantized = quantized;
+
+	if (quantized)
+	{
+		fmt.elements[POSITION] = Element{ 2, GL_SHORT, GL_TRUE, 0 };
+		fmt.elements[COLOR] = Element{ 4, GL_UNSIGNED_BYTE, GL_TRUE, 0 };
+		fmt.elements[NORMAL] = Element{ normals ? 2 : 0, GL_SHORT, GL_TRUE, 0 };
+		fmt.elements[TEXCOORD] = Element{ texcoords ? 2 : 0, GL_HALF_FLOAT, GL_FALSE, 0 };
+	}
+	else
+	{
+		fmt.elements[POSITION] = Element{ 2, GL_FLOAT, GL_FALSE, 0 };
+		fmt.elements[COLOR] = Element{ 3, GL_FLOAT, GL_FALSE, 0 };
+		fmt.elements[NORMAL] = Element{ normals ? 3 : 0, GL_FLOAT, GL_FALSE, 0 };
+		fmt.elements[TEXCOORD] = Element{ texcoords ? 2 : 0, GL_FLOAT, GL_FALSE, 0 };
+	}
+
+	GLuint offset = 0;
+	for (Element& e : fmt.elements)
+	{
+		e.offset = offset;
+		offset += (e.size * type_size(e.type) + 3) & ~3u;
+	}
+	fmt.stride = static_cast<GLsizei>(offset);
+	return fmt;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLVertexFormat::pack(...)
+
+@brief
+	This function converts and interleaves the vertex attributes. Quantized
+	positions are mapped from their AABB to [-1, 1] before being rounded to
+	snorm16, and pos_decode is set to undo the mapping.
+
+@return std::vector<GLubyte>
+	cnt * stride bytes of vertex data
+*/
+std::vector<GLubyte> GLVertexFormat::pack(glm::vec2 const* pos, glm::vec3 const* clr,
+	glm::vec3 const* nml, glm::vec2 const* uv, size_t cnt)
+{
+	std::vector<GLubyte> buf(cnt * stride, 0);
+	Element const& p = elements[POSITION];
+	Element const& c = elements[COLOR];
+	Element const& n = elements[NORMAL];
+	Element const& t = elements[TEXCOORD];
+
+	// Part 1: positions
+	if (quantized && cnt > 0)
+	{
+		glm::vec2 lo = pos[0], hi = pos[0];
+		for (size_t i = 0; i < cnt; i++)
+		{
+			lo = glm::min(lo, pos[i]);
+			hi = glm::max(hi, pos[i]);
+		}
+		glm::vec2 const half_extent = glm::max((hi - lo) * 0.5f, glm::vec2(1e-20f));
+		glm::vec2 const centre = (lo + hi) * 0.5f;
+		pos_decode = glm::vec4(half_extent, centre);
+
+		for (size_t i = 0; i < cnt; i++)
+		{
+			glm::vec2 const q = (pos[i] - centre) / half_extent;
+			put(buf, i, stride, p.offset, glm::packSnorm1x16(q.x));
+			put(buf, i, stride, p.offset + 2, glm::packSnorm1x16(q.y));
+		}
+	}
+	else
+	{
+		pos_decode = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+		for (size_t i = 0; i < cnt; i++)
+		{
+			put(buf, i, stride, p.offset, pos[i]);
+		}
+	}
+
+	// Part 2: the other attributes
+	for (size_t i = 0; i < cnt; i++)
+	{
+		if (quantized)
+		{
+			GLubyte const rgba[4] = { unorm8(clr[i].r), unorm8(clr[i].g), unorm8(clr[i].b), 255 };
+			put(buf, i, stride, c.offset, rgba);
+			if (n.size && nml)
+			{
+				glm::vec2 const e = encode_oct(nml[i]);
+				put(buf, i, stride, n.offset, glm::packSnorm1x16(e.x));
+				put(buf, i, stride, n.offset + 2, glm::packSnorm1x16(e.y));
+			}
+			if (t.size && uv)
+			{
+				put(buf, i, stride, t.offset, glm::packHalf1x16(uv[i].x));
+				put(buf, i, stride, t.offset + 2, glm::packHalf1x16(uv[i].y));
+			}
+		}
+		else
+		{
+			put(buf, i, stride, c.offset, clr[i]);
+			if (n.size && nml)
+			{
+				put(buf, i, stride, n.offset, nml[i]);
+			}
+			if (t.size && uv)
+			{
+				put(buf, i, stride, t.offset, uv[i]);
+			}
+		}
+	}
+	return buf;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLVertexFormat::apply(GLuint vaoid, GLuint vbo, GLuint binding) const
+
+@brief
+	This function binds vbo to binding of vaoid and sources every present
+	attribute from it, letting normalization decode the quantized ones.
+
+@return none
+*/
+void GLVertexFormat::apply(GLuint vaoid, GLuint vbo, GLuint binding) const
+{
+	glVertexArrayVertexBuffer(vaoid, binding, vbo, 0, stride);
+	for (GLuint a = 0; a < ATTRIB_CNT; a++)
+	{
+		Element const& e = elements[a];
+		if (e.size == 0)
+		{
+			continue;
+		}
+		GLuint const loc = location(static_cast<Attrib>(a));
+		glEnableVertexArrayAttrib(vaoid, loc);
+		glVertexArrayAttribFormat(vaoid, loc, e.size, e.type, e.normalized, e.offset);
+		glVertexArrayAttribBinding(vaoid, loc, binding);
+	}
+}
+
+GLuint GLVertexFormat::location(Attrib a)
+{
+	// 2 to 4 hold the per-instance model-to-NDC transform
+	GLuint const locations[ATTRIB_CNT] = { 0, 1, 5, 6 };
+	return locations[a];
+}
+
+/*  _________________________________________________________________________*/
+/*! GLVertexFormat::encode_oct(glm::vec3 n)
+
+@brief
+	This function projects a unit normal onto the octahedron |x|+|y|+|z|=1
+	and unfolds the lower half over the upper one, giving a point of
+	[-1, 1]^2 that is then stored as two snorm16.
+
+@return glm::vec2
+*/
+glm::vec2 GLVertexFormat::encode_oct(glm::vec3 n)
+{
+	n /= std::max(std::abs(n.x) + std::abs(n.y) + std::abs(n.z), 1e-20f);
+	glm::vec2 e(n.x, n.y);
+	if (n.z < 0.0f)
+	{
+		glm::vec2 const sign(e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f);
+		e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) * sign;
+	}
+	return e;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLVertexFormat::decode_oct(glm::vec2 e)
+
+@brief
+	This function is the inverse of encode_oct; shaders reading quantized
+	normals apply the same steps.
+
+@return glm::vec3
+	unit normal
+*/
+glm::vec3 GLVertexFormat::decode_oct(glm::vec2 e)
+{
+	glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+	float const t = std::max(-n.z, 0.0f);
+	n.x += (n.x >= 0.0f) ? -t : t;
+	n.y += (n.y >= 0.0f) ? -t : t;
+	return glm::normalize(n);
+}
@@ -0,0 +1,697 @@
+/*!
+@file		glxform.cpp
+@author		tan.a@digipen.edu
+@date		17/10/2026
+
+This file implements the batched object transform kernel declared in
+glxform.h: a scalar, an SSE2 and an AVX2 path sharing one polynomial sin/cos
+approximation, the glm reference path they are verified against, and a
+microbenchmark comparing all of them.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glxform.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>								// std::min, std::max
+#include <atomic>									// std::atomic
+#include <chrono>									// std::chrono
+#include <cmath>									// std::nearbyint
+#include <iomanip>									// std::setw
+#include <mutex>									// std::call_once
+#include <random>									// std::mt19937
+#include <vector>									// std::vector
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define GLXFORM_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC emits any intrinsic regardless of /arch, so no per-function target is needed
+#define GLXFORM_TARGET_SSE2
+#define GLXFORM_TARGET_AVX2
+#else
+#define GLXFORM_TARGET_SSE2 __attribute__((target("sse2")))
+#define GLXFORM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace {
+
+	// Minimax coefficients of sin and cos on [-pi/4, pi/4] (as used by the
+	// Cephes single precision library):
+	// sin(r) ~ r + r^3 * (S1 + r^2 * (S2 + r^2 * S3))
+	// cos(r) ~ 1 - r^2 / 2 + r^4 * (C1 + r^2 * (C2 + r^2 * C3))
+	constexpr GLfloat S1 = -1.6666654611e-1f;
+	constexpr GLfloat S2 = 8.3321608736e-3f;
+	constexpr GLfloat S3 = -1.9515295891e-4f;
+	constexpr GLfloat C1 = 4.166664568298827e-2f;
+	constexpr GLfloat C2 = -1.388731625493765e-3f;
+	constexpr GLfloat C3 = 2.443315711809948e-5f;
+
+	constexpr GLfloat DEG_TO_RAD = 0.017453292519943295f;
+	constexpr GLfloat INV_90 = 1.0f / 90.0f;
+
+	// path() runs on job threads, so the path is detected once under
+	// path_once and read atomically
+	std::once_flag path_once;
+	std::atomic<GLXform::Path> selected_path{ GLXform::Path::SCALAR };
+
+	/*  _________________________________________________________________________*/
+	/*! write_xform
+
+	@brief
+		This function writes the 2x3 affine terms of one object into a full
+		column-major 3x3 matrix.
+
+	@return none
+	*/
+	inline void write_xform(glm::mat3& m, GLfloat m00, GLfloat m01,
+		GLfloat m10, GLfloat m11, GLfloat m20, GLfloat m21)
+	{
+		m[0] = glm::vec3(m00, m01, 0.0f);
+		m[1] = glm::vec3(m10, m11, 0.0f);
+		m[2] = glm::vec3(m20, m21, 1.0f);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! destination
+
+	@brief
+		This function returns the matrix that receives the transform of
+		object i: mdl_to_ndc_xform[xform_index[i]], or mdl_to_ndc_xform[i]
+		when there is no index, or nullptr if the index is GLXform::SKIP.
+
+	@return glm::mat3*
+	*/
+	inline glm::mat3* destination(glm::mat3* mdl_to_ndc_xform, GLuint const* xform_index, size_t i)
+	{
+		if (!xform_index)
+		{
+			return mdl_to_ndc_xform + i;
+		}
+		return (xform_index[i] != GLXform::SKIP) ? mdl_to_ndc_xform + xform_index[i] : nullptr;
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! update_scalar
+
+	@brief
+		Scalar path of GLXform::update. Also used for the objects left over
+		after the SIMD paths have processed all complete groups.
+
+	@return none
+	*/
+	void update_scalar(size_t begin, size_t end, GLfloat* angle_disp, GLfloat const* angle_speed,
+		glm::vec2 const* position, glm::vec2 const* scaling,
+		glm::mat3* mdl_to_ndc_xform, GLuint const* xform_index,
+		GLfloat delta_time, glm::vec2 world_to_ndc, glm::vec2 ndc_offset)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			GLfloat const angle = angle_disp[i] + angle_speed[i] * delta_time;
+			angle_disp[i] = angle;
+
+			glm::mat3* const m = destination(mdl_to_ndc_xform, xform_index, i);
+			if (!m)
+			{
+				continue;
+			}
+
+			GLfloat s, c;
+			GLXform::sincos_deg(angle, s, c);
+
+			write_xform(*m,
+				world_to_ndc.x * scaling[i].x * c, world_to_ndc.y * scaling[i].x * s,
+				-(world_to_ndc.x * scaling[i].y * s), world_to_ndc.y * scaling[i].y * c,
+				world_to_ndc.x * position[i].x + ndc_offset.x, world_to_ndc.y * position[i].y + ndc_offset.y);
+		}
+	}
+
+#ifdef GLXFORM_X86
+	/*  _________________________________________________________________________*/
+	/*! sincos_deg_sse2
+
+	@brief
+		Four-wide version of GLXform::sincos_deg. Produces the same results as
+		the scalar version since it performs the same operations in the same
+		order.
+
+	@return none
+	*/
+	GLXFORM_TARGET_SSE2 inline void sincos_deg_sse2(__m128 deg, __m128& s, __m128& c)
+	{
+		__m128i const one = _mm_set1_epi32(1);
+		__m128i const two = _mm_set1_epi32(2);
+
+		// reduce to r in [-45, 45] degrees and quadrant q
+		__m128i const qi = _mm_cvtps_epi32(_mm_mul_ps(deg, _mm_set1_ps(INV_90)));
+		__m128 const q = _mm_cvtepi32_ps(qi);
+		__m128 const r = _mm_mul_ps(_mm_sub_ps(deg, _mm_mul_ps(q, _mm_set1_ps(90.0f))),
+			_mm_set1_ps(DEG_TO_RAD));
+		__m128 const r2 = _mm_mul_ps(r, r);
+
+		__m128 sin_r = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(S3)), _mm_set1_ps(S2));
+		sin_r = _mm_add_ps(_mm_mul_ps(r2, sin_r), _mm_set1_ps(S1));
+		sin_r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), sin_r));
+
+		__m128 cos_r = _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(C3)), _mm_set1_ps(C2));
+		cos_r = _mm_add_ps(_mm_mul_ps(r2, cos_r), _mm_set1_ps(C1));
+		cos_r = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))),
+			_mm_mul_ps(_mm_mul_ps(r2, r2), cos_r));
+
+		// odd quadrants swap sin and cos, quadrants 2 and 3 negate sin,
+		// quadrants 1 and 2 negate cos
+		__m128 const swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(qi, one), one));
+		__m128 const sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(qi, two), 30));
+		__m128 const cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(qi, one), two), 30));
+
+		s = _mm_or_ps(_mm_and_ps(swap, cos_r), _mm_andnot_ps(swap, sin_r));
+		c = _mm_or_ps(_mm_and_ps(swap, sin_r), _mm_andnot_ps(swap, cos_r));
+		s = _mm_xor_ps(s, sin_sign);
+		c = _mm_xor_ps(c, cos_sign);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! update_sse2
+
+	@brief
+		SSE2 path of GLXform::update, four objects per iteration.
+
+	@return none
+	*/
+	GLXFORM_TARGET_SSE2 void update_sse2(size_t begin, size_t end, GLfloat* angle_disp, GLfloat const* angle_speed,
+		glm::vec2 const* position, glm::vec2 const* scaling,
+		glm::mat3* mdl_to_ndc_xform, GLuint const* xform_index,
+		GLfloat delta_time, glm::vec2 world_to_ndc, glm::vec2 ndc_offset)
+	{
+		__m128 const dt = _mm_set1_ps(delta_time);
+		__m128 const kx = _mm_set1_ps(world_to_ndc.x);
+		__m128 const ky = _mm_set1_ps(world_to_ndc.y);
+		__m128 const ox = _mm_set1_ps(ndc_offset.x);
+		__m128 const oy = _mm_set1_ps(ndc_offset.y);
+
+		alignas(16) GLfloat terms[6][4];
+
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 const angle = _mm_add_ps(_mm_loadu_ps(angle_disp + i),
+				_mm_mul_ps(_mm_loadu_ps(angle_speed + i), dt));
+			_mm_storeu_ps(angle_disp + i, angle);
+
+			__m128 s, c;
+			sincos_deg_sse2(angle, s, c);
+
+			// de-interleave x and y of four glm::vec2
+			__m128 const p01 = _mm_loadu_ps(glm::value_ptr(position[i]));
+			__m128 const p23 = _mm_loadu_ps(glm::value_ptr(position[i + 2]));
+			__m128 const s01 = _mm_loadu_ps(glm::value_ptr(scaling[i]));
+			__m128 const s23 = _mm_loadu_ps(glm::value_ptr(scaling[i + 2]));
+			__m128 const px = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 const py = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+			__m128 const sx = _mm_shuffle_ps(s01, s23, _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 const sy = _mm_shuffle_ps(s01, s23, _MM_SHUFFLE(3, 1, 3, 1));
+
+			_mm_store_ps(terms[0], _mm_mul_ps(_mm_mul_ps(kx, sx), c));
+			_mm_store_ps(terms[1], _mm_mul_ps(_mm_mul_ps(ky, sx), s));
+			_mm_store_ps(terms[2], _mm_xor_ps(_mm_mul_ps(_mm_mul_ps(kx, sy), s), _mm_set1_ps(-0.0f)));
+			_mm_store_ps(terms[3], _mm_mul_ps(_mm_mul_ps(ky, sy), c));
+			_mm_store_ps(terms[4], _mm_add_ps(_mm_mul_ps(kx, px), ox));
+			_mm_store_ps(terms[5], _mm_add_ps(_mm_mul_ps(ky, py), oy));
+
+			for (size_t l = 0; l < 4; l++)
+			{
+				if (glm::mat3* const m = destination(mdl_to_ndc_xform, xform_index, i + l))
+				{
+					write_xform(*m, terms[0][l], terms[1][l],
+						terms[2][l], terms[3][l], terms[4][l], terms[5][l]);
+				}
+			}
+		}
+
+		update_scalar(i, end, angle_disp, angle_speed, position, scaling,
+			mdl_to_ndc_xform, xform_index, delta_time, world_to_ndc, ndc_offset);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! sincos_deg_avx2
+
+	@brief
+		Eight-wide version of GLXform::sincos_deg.
+
+	@return none
+	*/
+	GLXFORM_TARGET_AVX2 inline void sincos_deg_avx2(__m256 deg, __m256& s, __m256& c)
+	{
+		__m256i const one = _mm256_set1_epi32(1);
+		__m256i const two = _mm256_set1_epi32(2);
+
+		__m256i const qi = _mm256_cvtps_epi32(_mm256_mul_ps(deg, _mm256_set1_ps(INV_90)));
+		__m256 const q = _mm256_cvtepi32_ps(qi);
+		__m256 const r = _mm256_mul_ps(_mm256_sub_ps(deg, _mm256_mul_ps(q, _mm256_set1_ps(90.0f))),
+			_mm256_set1_ps(DEG_TO_RAD));
+		__m256 const r2 = _mm256_mul_ps(r, r);
+
+		__m256 sin_r = _mm256_add_ps(_mm256_mul_ps(r2, _mm256_set1_ps(S3)), _mm256_set1_ps(S2));
+		sin_r = _mm256_add_ps(_mm256_mul_ps(r2, sin_r), _mm256_set1_ps(S1));
+		sin_r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), sin_r));
+
+		__m256 cos_r = _mm256_add_ps(_mm256_mul_ps(r2, _mm256_set1_ps(C3)), _mm256_set1_ps(C2));
+		cos_r = _mm256_add_ps(_mm256_mul_ps(r2, cos_r), _mm256_set1_ps(C1));
+		cos_r = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))),
+			_mm256_mul_ps(_mm256_mul_ps(r2, r2), cos_r));
+
+		__m256 const swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(qi, one), one));
+		__m256 const sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(qi, two), 30));
+		__m256 const cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(qi, one), two), 30));
+
+		s = _mm256_xor_ps(_mm256_blendv_ps(sin_r, cos_r, swap), sin_sign);
+		c = _mm256_xor_ps(_mm256_blendv_ps(cos_r, sin_r, swap), cos_sign);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! deinterleave_avx2
+
+	@brief
+		This function splits eight consecutive glm::vec2 into their x and y
+		components.
+
+	@return none
+	*/
+	GLXFORM_TARGET_AVX2 inline void deinterleave_avx2(glm::vec2 const* v, __m256& x, __m256& y)
+	{
+		__m256 const v0 = _mm256_loadu_ps(glm::value_ptr(v[0]));
+		__m256 const v1 = _mm256_loadu_ps(glm::value_ptr(v[4]));
+		// in-lane shuffles give x0 x1 x4 x5 | x2 x3 x6 x7, the 64-bit
+		// permutation restores the order x0 .. x7
+		x = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(
+			_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+		y = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(
+			_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! update_avx2
+
+	@brief
+		AVX2 path of GLXform::update, eight objects per iteration.
+
+	@return none
+	*/
+	GLXFORM_TARGET_AVX2 void update_avx2(size_t begin, size_t end, GLfloat* angle_disp, GLfloat const* angle_speed,
+		glm::vec2 const* position, glm::vec2 const* scaling,
+		glm::mat3* mdl_to_ndc_xform, GLuint const* xform_index,
+		GLfloat delta_time, glm::vec2 world_to_ndc, glm::vec2 ndc_offset)
+	{
+		__m256 const dt = _mm256_set1_ps(delta_time);
+		__m256 const kx = _mm256_set1_ps(world_to_ndc.x);
+		__m256 const ky = _mm256_set1_ps(world_to_ndc.y);
+		__m256 const ox = _mm256_set1_ps(ndc_offset.x);
+		__m256 const oy = _mm256_set1_ps(ndc_offset.y);
+
+		alignas(32) GLfloat terms[6][8];
+
+		size_t i = begin;
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 const angle = _mm256_add_ps(_mm256_loadu_ps(angle_disp + i),
+				_mm256_mul_ps(_mm256_loadu_ps(angle_speed + i), dt));
+			_mm256_storeu_ps(angle_disp + i, angle);
+
+			__m256 s, c;
+			sincos_deg_avx2(angle, s, c);
+
+			__m256 px, py, sx, sy;
+			deinterleave_avx2(position + i, px, py);
+			deinterleave_avx2(scaling + i, sx, sy);
+
+			_mm256_store_ps(terms[0], _mm256_mul_ps(_mm256_mul_ps(kx, sx), c));
+			_mm256_store_ps(terms[1], _mm256_mul_ps(_mm256_mul_ps(ky, sx), s));
+			_mm256_store_ps(terms[2], _mm256_xor_ps(_mm256_mul_ps(_mm256_mul_ps(kx, sy), s), _mm256_set1_ps(-0.0f)));
+			_mm256_store_ps(terms[3], _mm256_mul_ps(_mm256_mul_ps(ky, sy), c));
+			_mm256_store_ps(terms[4], _mm256_add_ps(_mm256_mul_ps(kx, px), ox));
+			_mm256_store_ps(terms[5], _mm256_add_ps(_mm256_mul_ps(ky, py), oy));
+
+			for (size_t l = 0; l < 8; l++)
+			{
+				if (glm::mat3* const m = destination(mdl_to_ndc_xform, xform_index, i + l))
+				{
+					write_xform(*m, terms[0][l], terms[1][l],
+						terms[2][l], terms[3][l], terms[4][l], terms[5][l]);
+				}
+			}
+		}
+
+		update_sse2(i, end, angle_disp, angle_speed, position, scaling,
+			mdl_to_ndc_xform, xform_index, delta_time, world_to_ndc, ndc_offset);
+	}
+
+	/*  _________________________________________________________________________*/
+	/*! cpu_supports
+
+	@brief
+		This function queries the CPU (and for AVX2 the OS) for support of the
+		given path.
+
+	@return bool
+		true if the path can run on this machine
+	*/
+	bool cpu_supports(GLXform::Path p)
+	{
+		if (p == GLXform::Path::SCALAR)
+		{
+			return true;
+		}
+#if defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, 1);
+		bool const sse2 = (regs[3] & (1 << 26)) != 0;
+		if (p == GLXform::Path::SSE2)
+		{
+			return sse2;
+		}
+		bool const osxsave = (regs[2] & (1 << 27)) != 0;
+		bool const avx = (regs[2] & (1 << 28)) != 0;
+		if (!sse2 || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+		{
+			return false;
+		}
+		__cpuidex(regs, 7, 0);
+		return (regs[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		if (p == GLXform::Path::SSE2)
+		{
+			return __builtin_cpu_supports("sse2");
+		}
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#else
+	bool cpu_supports(GLXform::Path p)
+	{
+		return p == GLXform::Path::SCALAR;
+	}
+#endif
+
+	// p, or the best supported path below it
+	GLXform::Path supported_path(GLXform::Path p)
+	{
+		while (!cpu_supports(p))
+		{
+			p = (p == GLXform::Path::AVX2) ? GLXform::Path::SSE2 : GLXform::Path::SCALAR;
+		}
+		return p;
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLXform::sincos_deg(GLfloat deg, GLfloat& s, GLfloat& c)
+
+@brief
+	This function approximates the sine and cosine of an angle in degrees.
+
+	The angle is reduced to r in [-45, 45] degrees and a quadrant
+	q = round(deg / 90). Reducing in degrees keeps q * 90 exact, so the only
+	reduction error is the rounding of deg - q * 90, at most half an ulp of
+	45 (about 1.9e-6 degrees, or 3.3e-8 radians). Minimax polynomials of
+	degree 7 (sin) and 8 (cos) then evaluate r in radians with a maximum
+	error of about 6e-8, and the quadrant swaps and negates the results.
+
+	Measured against double precision sin/cos, the maximum absolute error is
+	below GLXform::SINCOS_MAX_ERROR (2.5e-7) for |deg| <= 1e5. Beyond that
+	the error is dominated by the precision of deg itself, which is the
+	same for cosf(glm::radians(deg)).
+
+@param deg
+	angle in degrees
+
+@param s
+	receives sin(deg)
+
+@param c
+	receives cos(deg)
+
+@return none
+*/
+void GLXform::sincos_deg(GLfloat deg, GLfloat& s, GLfloat& c)
+{
+	GLfloat const q = std::nearbyint(deg * INV_90);
+	int const qi = static_cast<int>(q);
+	GLfloat const r = (deg - q * 90.0f) * DEG_TO_RAD;
+	GLfloat const r2 = r * r;
+
+	GLfloat const sin_r = r + (r * r2) * ((r2 * S3 + S2) * r2 + S1);
+	GLfloat const cos_r = (1.0f - r2 * 0.5f) + (r2 * r2) * ((r2 * C3 + C2) * r2 + C1);
+
+	// odd quadrants swap sin and cos, quadrants 2 and 3 negate sin,
+	// quadrants 1 and 2 negate cos
+	s = (qi & 1) ? cos_r : sin_r;
+	c = (qi & 1) ? sin_r : cos_r;
+	s = (qi & 2) ? -s : s;
+	c = ((qi + 1) & 2) ? -c : c;
+}
+
+/*  _________________________________________________________________________*/
+/*! GLXform::update
+
+@brief
+	This function integrates the angular displacement of count objects and
+	writes their model-to-NDC transforms using the selected path.
+	See glxform.h for the description of the parameters.
+
+@return none
+*/
+void GLXform::update(size_t count, GLfloat* angle_disp, GLfloat const* angle_speed,
+	glm::vec2 const* position, glm::vec2 const* scaling,
+	glm::mat3* mdl_to_ndc_xform, GLuint const* xform_index,
+	GLfloat delta_time, glm::vec2 world_to_ndc, glm::vec2 ndc_offset)
+{
+	switch (GLXform::path())
+	{
+#ifdef GLXFORM_X86
+	case Path::AVX2:
+		update_avx2(0, count, angle_disp, angle_speed, position, scaling,
+			mdl_to_ndc_xform, xform_index, delta_time, world_to_ndc, ndc_offset);
+		break;
+	case Path::SSE2:
+		update_sse2(0, count, angle_disp, angle_speed, position, scaling,
+			mdl_to_ndc_xform, xform_index, delta_time, world_to_ndc, ndc_offset);
+		break;
+#endif
+	default:
+		update_scalar(0, count, angle_disp, angle_speed, position, scaling,
+			mdl_to_ndc_xform, xform_index, delta_time, world_to_ndc, ndc_offset);
+		break;
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLXform::update_reference
+
+@brief
+	This function updates count objects with full glm matrices: the way
+	objects were updated before the batched kernel existed.
+	See glxform.h for the description of the parameters.
+
+@return none
+*/
+void GLXform::update_reference(size_t count, GLfloat* angle_disp, GLfloat const* angle_speed,
+	glm::vec2 const* position, glm::vec2 const* scaling,
+	glm::mat3* mdl_to_ndc_xform, GLfloat delta_time, glm::vec2 world_to_ndc)
+{
+	// Compute the scaling matrix to map from world coordinates to NDC coordinates
+	glm::mat3 const ScaleToWorldToNDC = glm::mat3(
+		world_to_ndc.x, 0.0f, 0.0f,
+		0.0f, world_to_ndc.y, 0.0f,
+		0.0f, 0.0f, 1.0f
+	);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		angle_disp[i] += (angle_speed[i] * delta_time);
+
+		// Compute the scale matrix
+		glm::mat3 Scale = glm::mat3(
+			scaling[i].x, 0.0f, 0.0f,
+			0.0f, scaling[i].y, 0.0f,
+			0.0f, 0.0f, 1.0f
+		);
+
+		// Compute the rotation matrix
+		glm::mat3 Rotation = glm::mat3(
+			cosf(glm::radians(angle_disp[i])), -sinf(glm::radians(angle_disp[i])), 0.0f,
+			sinf(glm::radians(angle_disp[i])), cosf(glm::radians(angle_disp[i])), 0.0f,
+			0.0f, 0.0f, 1.0f
+		);
+
+		// Compute the translation matrix
+		glm::mat3 Translation = glm::mat3(
+			1.0f, 0.0f, position[i].x,
+			0.0f, 1.0f, position[i].y,
+			0.0f, 0.0f, 1.0f
+		);
+
+		// Compute the model-to-world-to-NDC transformation matrix
+		mdl_to_ndc_xform[i] = ScaleToWorldToNDC * glm::transpose(Translation) * glm::transpose(Rotation) * glm::transpose(Scale);
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLXform::path, GLXform::set_path, GLXform::path_name
+
+@brief
+	These functions select the instruction set used by GLXform::update.
+	The best supported path is selected the first time path() is called,
+	from any thread. set_path() is called by the main thread while no job
+	uses the path.
+
+@return Path / none / char const*
+*/
+GLXform::Path GLXform::path()
+{
+	std::call_once(path_once, [] { selected_path.store(supported_path(Path::AVX2), std::memory_order_relaxed); });
+	return selected_path.load(std::memory_order_relaxed);
+}
+
+void GLXform::set_path(Path p)
+{
+	// an override made before the first path() isn't replaced by detection
+	std::call_once(path_once, [] {});
+	selected_path.store(supported_path(p), std::memory_order_relaxed);
+}
+
+char const* GLXform::path_name(Path p)
+{
+	switch (p)
+	{
+	case Path::AVX2: return "avx2";
+	case Path::SSE2: return "sse2";
+	default: return "scalar";
+	}
+}
+
+/*  _________________________________________________________________________*/
+/*! GLXform::benchmark(std::ostream& os)
+
+@brief
+	This function times update_reference() and every supported path of
+	update() at 1k, 32k and 1M objects. Each measurement is the fastest of
+	several repetitions of one update of all objects. Before timing, every
+	path is run once from the same state as the reference and the largest
+	absolute difference over all transform elements is reported.
+
+@param os
+	stream the results are printed to
+
+@return bool
+	true if every path matched the reference within GLXform::TOLERANCE
+*/
+bool GLXform::benchmark(std::ostream& os)
+{
+	size_t const sizes[] = { 1000, 32768, 1u << 20 };
+	Path const paths[] = { Path::SCALAR, Path::SSE2, Path::AVX2 };
+	glm::vec2 const world_to_ndc{ 1.0f / 5000.0f, 1.0f / 5000.0f };
+	GLfloat const delta_time = 1.0f / 60.0f;
+
+	Path const prev_path = GLXform::path();
+	bool passed = true;
+
+	os << std::setw(10) << "objects" << std::setw(10) << "path"
+		<< std::setw(14) << "ms/update" << std::setw(14) << "ns/object"
+		<< std::setw(10) << "speedup" << std::setw(14) << "max error" << '\n';
+
+	for (size_t const n : sizes)
+	{
+		std::mt19937 gen(12345u);
+		std::uniform_real_distribution<GLfloat> angle(0.0f, 360.0f), speed(0.0f, 30.0f),
+			pos(-5000.0f, 5000.0f), scale(50.0f, 450.0f);
+
+		std::vector<GLfloat> angle_disp(n), angle_speed(n);
+		std::vector<glm::vec2> position(n), scaling(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			angle_disp[i] = angle(gen);
+			angle_speed[i] = speed(gen);
+			position[i] = glm::vec2(pos(gen), pos(gen));
+			scaling[i] = glm::vec2(scale(gen), scale(gen));
+		}
+
+		std::vector<glm::mat3> expected(n), actual(n);
+		std::vector<GLfloat> work(n);
+
+		// at least 8 repetitions and roughly 32M objects updated per path
+		size_t const reps = std::max<size_t>(8, (size_t(32) << 20) / n);
+
+		// time one path, starting each repetition from the same angles
+		auto time_path = [&](bool reference, std::vector<glm::mat3>& out) {
+			double best = 1e30;
+			for (size_t r = 0; r < reps; r++)
+			{
+				std::copy(angle_disp.begin(), angle_disp.end(), work.begin());
+				auto const start = std::chrono::steady_clock::now();
+				if (reference)
+				{
+					GLXform::update_reference(n, work.data(), angle_speed.data(), position.data(),
+						scaling.data(), out.data(), delta_time, world_to_ndc);
+				}
+				else
+				{
+					GLXform::update(n, work.data(), angle_speed.data(), position.data(),
+						scaling.data(), out.data(), nullptr, delta_time, world_to_ndc);
+				}
+				std::chrono::duration<double, std::milli> const elapsed =
+					std::chrono::steady_clock::now() - start;
+				best = std::min(best, elapsed.count());
+			}
+			return best;
+		};
+
+		double const reference_ms = time_path(true, expected);
+		os << std::setw(10) << n << std::setw(10) << "glm"
+			<< std::setw(14) << std::fixed << std::setprecision(4) << reference_ms
+			<< std::setw(14) << std::setprecision(2) << reference_ms * 1e6 / static_cast<double>(n)
+			<< std::setw(10) << "1.00x" << std::setw(14) << "-" << '\n';
+
+		for (Path const p : paths)
+		{
+			if (!cpu_supports(p))
+			{
+				continue;
+			}
+			GLXform::set_path(p);
+
+			double const ms = time_path(false, actual);
+
+			GLfloat max_error = 0.0f;
+			for (size_t i = 0; i < n; i++)
+			{
+				for (int col = 0; col < 3; col++)
+				{
+					for (int row = 0; row < 3; row++)
+					{
+						max_error = std::max(max_error, std::abs(actual[i][col][row] - expected[i][col][row]));
+					}
+				}
+			}
+			passed = passed && (max_error <= GLXform::TOLERANCE);
+
+			os << std::setw(10) << n << std::setw(10) << GLXform::path_name(p)
+				<< std::setw(14) << std::fixed << std::setprecision(4) << ms
+				<< std::setw(14) << std::setprecision(2) << ms * 1e6 / static_cast<double>(n)
+				<< std::setw(9) << reference_ms / ms << 'x'
+				<< std::setw(14) << std::scientific << std::setprecision(2) << max_error
+				<< std::defaultfloat << (max_error <= GLXform::TOLERANCE ? "" : "  FAIL") << '\n';
+		}
+	}
+
+	os << "tolerance: " << GLXform::TOLERANCE << (passed ? "  (all paths passed)" : "  (FAILED)") << '\n';
+
+	GLXform::set_path(prev_path);
+	return passed;
+}
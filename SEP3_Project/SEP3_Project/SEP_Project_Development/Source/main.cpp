@@ -14,24 +14,77 @@ an OpenGL context and implement a game loop.
 // Extension loader library's header must be included before GLFW's header!!!
 #include <glhelper.h>
 #include <glapp.h>
+#include <glxform.h>
+#include <gljobs.h>
+#include <glbench.h>
+#include <glprofiler.h>
+#include <glstate.h>
+#include <glrandom.h>
 #include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <vector>
+#include <algorithm>
 
 /*                                                   type declarations
 ----------------------------------------------------------------------------- */
+// Options of a headless run, read from the command line
+struct HeadlessOptions {
+    bool enabled = false;       // --headless
+    unsigned frames = 1000;     // --frames N
+    size_t objects = 1024;      // --objects N
+};
 
 /*                                                      function declarations
 ----------------------------------------------------------------------------- */
 static void draw();
 static void update();
-static void init();
+static void init(bool headless = false);
 static void cleanup();
+static int run_headless(HeadlessOptions const& opt);
+static bool parse_number(char const* option, char const* arg,
+    unsigned long long min, unsigned long long max, unsigned long long& value);
 
 /*                                                      function definitions
 ----------------------------------------------------------------------------- */
 /*  _________________________________________________________________________ */
 /*! main
 
-@param none
+@param int argc
+@param char* argv[]
+Command line arguments. "--bench-xform" runs the transform kernel
+microbenchmark (see GLXform::benchmark) instead of the application.
+"--headless" renders a fixed number of frames ("--frames N") of a fixed
+number of objects ("--objects N") offscreen, without a visible window, and
+prints a timing report (see run_headless); the invisible window still needs
+a display, e.g. Xvfb on a Linux CI machine (see GLHelper::init).
+"--bench" replays the scripted scenarios of GLBench headless; it takes
+"--repeat N", "--settle N", "--steady N", "--label S", "--csv PATH" and
+"--json PATH" and "--compare-sim" (see GLBench::Options).
+"--max-objects N" sets the object budget, from 1 to
+GLApp::MAX_OBJECT_BUDGET (see GLApp::max_objects).
+"--seed N" seeds the random initial states of the objects and the colors
+of the box model, which are otherwise different every run (see GLRandom).
+"--mesh PATH" adds the OBJ file at PATH as a second model (see GLMesh).
+"--float-vertices" stores the models' vertices as floats instead of
+quantized (see GLVertexFormat).
+"--gpu-cull" culls the objects and generates their draw commands with
+compute shaders (see GLGpuCull).
+"--gpu-sim" also keeps the objects' states on the GPU and integrates them
+with a compute shader (see GLGpuSim); 'G' switches between the CPU and GPU
+simulation whenever GPU culling is enabled.
+"--no-shader-cache" always compiles the shaders from source instead of
+reloading the program binaries saved by earlier runs (see GLSLShader).
+"--hot-reload" rebuilds a shader program when its files change (see
+GLApp::reload_shdrpgms).
+Every N must be a whole number in range (see parse_number); the program
+exits with an error otherwise.
 
 @return int
 
@@ -39,7 +92,120 @@ Indicates how the program existed. Normal exit is signaled by a return value of
 0. Abnormal termination is signaled by a non-zero return value.
 Note that the C++ compiler will insert a return 0 statement if one is missing.
 */
-int main() {
+int main(int argc, char* argv[]) {
+    // Part 0: the microbenchmark needs no OpenGL context
+    if (argc > 1 && std::strcmp(argv[1], "--bench-xform") == 0) {
+        return GLXform::benchmark(std::cout) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    HeadlessOptions headless;
+    GLBench::Options bench;
+    bool run_bench = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless.enabled = true;
+        }
+        else if (std::strcmp(argv[i], "--max-objects") == 0 && i + 1 < argc) {
+            unsigned long long budget = 0;
+            if (!parse_number(argv[i], argv[i + 1], 1, GLApp::MAX_OBJECT_BUDGET, budget)) {
+                return EXIT_FAILURE;
+            }
+            GLApp::max_objects = static_cast<size_t>(budget);
+            i++;
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            unsigned long long value = 0;
+            if (!parse_number(argv[i], argv[i + 1], 0, ULLONG_MAX, value)) {
+                return EXIT_FAILURE;
+            }
+            GLRandom::seed = static_cast<std::uint64_t>(value);
+            i++;
+        }
+        else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc) {
+            GLApp::mesh_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--float-vertices") == 0) {
+            GLApp::quantize_vertices = false;
+        }
+        else if (std::strcmp(argv[i], "--gpu-cull") == 0) {
+            GLGpuCull::enabled = true;
+        }
+        else if (std::strcmp(argv[i], "--gpu-sim") == 0) {
+            GLGpuSim::enabled = true;
+        }
+        else if (std::strcmp(argv[i], "--no-shader-cache") == 0) {
+            GLSLShader::binary_cache_dir.clear();
+        }
+        else if (std::strcmp(argv[i], "--hot-reload") == 0) {
+            GLApp::hot_reload = true;
+        }
+        else if (std::strcmp(argv[i], "--bench") == 0) {
+            run_bench = true;
+        }
+        else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            unsigned long long value = 0;
+            if (!parse_number(argv[i], argv[i + 1], 1, UINT_MAX, value)) {
+                return EXIT_FAILURE;
+            }
+            bench.repeat = static_cast<unsigned>(value);
+            i++;
+        }
+        else if (std::strcmp(argv[i], "--settle") == 0 && i + 1 < argc) {
+            unsigned long long value = 0;
+            if (!parse_number(argv[i], argv[i + 1], 0, UINT_MAX, value)) {
+                return EXIT_FAILURE;
+            }
+            bench.settle_frames = static_cast<unsigned>(value);
+            i++;
+        }
+        else if (std::strcmp(argv[i], "--steady") == 0 && i + 1 < argc) {
+            unsigned long long value = 0;
+            if (!parse_number(argv[i], argv[i + 1], 1, UINT_MAX, value)) {
+                return EXIT_FAILURE;
+            }
+            bench.steady_frames = static_cast<unsigned>(value);
+            i++;
+        }
+        else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            bench.label = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            bench.csv_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            bench.json_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--compare-sim") == 0) {
+            bench.compare_sim = true;
+            GLGpuCull::enabled = true;
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            unsigned long long value = 0;
+            if (!parse_number(argv[i], argv[i + 1], 1, UINT_MAX, value)) {
+                return EXIT_FAILURE;
+            }
+            headless.frames = static_cast<unsigned>(value);
+            i++;
+        }
+        else if (std::strcmp(argv[i], "--objects") == 0 && i + 1 < argc) {
+            unsigned long long value = 0;
+            if (!parse_number(argv[i], argv[i + 1], 1, SIZE_MAX, value)) {
+                return EXIT_FAILURE;
+            }
+            headless.objects = static_cast<size_t>(value);
+            i++;
+        }
+    }
+    if (run_bench) {
+        init(true);
+        bool const ok = GLBench::run(bench);
+        cleanup();
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (headless.enabled) {
+        return run_headless(headless);
+    }
+
     // Part 1
     init();
 
@@ -55,6 +221,122 @@ int main() {
     cleanup();
 }
 
+/*  _________________________________________________________________________ */
+/*! parse_number
+@param char const* option
+Name of the option, for the error message
+@param char const* arg
+Argument of the option
+@param unsigned long long min
+@param unsigned long long max
+Range of the argument, bounds included
+@param unsigned long long& value
+Receives the argument if it is valid
+
+@return bool
+true if arg is a decimal whole number from min to max; otherwise an error
+is printed
+
+Reads the argument of a numeric option. Arguments that don't start with a
+digit (empty, signed or with leading spaces), have trailing characters or
+are out of range are rejected, instead of read as 0 or wrapped around as
+strtoull does.
+*/
+static bool parse_number(char const* option, char const* arg,
+    unsigned long long min, unsigned long long max, unsigned long long& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoull(arg, &end, 10);
+    if (!std::isdigit(static_cast<unsigned char>(arg[0])) || *end != '\0' || errno == ERANGE
+        || value < min || value > max) {
+        std::cerr << option << " takes a whole number from " << min << " to "
+            << max << ", not \"" << arg << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*  _________________________________________________________________________ */
+/*! run_headless
+@param HeadlessOptions const& opt
+Number of frames to render and number of objects to render them with
+
+@return int
+EXIT_SUCCESS, or EXIT_FAILURE if no object could be spawned
+
+Runs the same GLApp::init/update/draw code as the windowed game loop, but
+into an offscreen framebuffer and for a fixed number of frames. The objects
+are spawned up front, so every frame updates and draws opt.objects objects.
+The CPU time of each frame (update + draw, without waiting for the GPU) is
+measured; the total includes a final glFinish so that it covers all GPU
+work. A timing report is printed when done, followed by the rolling average
+CPU and GPU times of the frame stages (see GLProfiler).
+*/
+static int run_headless(HeadlessOptions const& opt) {
+    // Part 1
+    init(true);
+
+    if (opt.objects > GLApp::max_objects) {
+        std::cout << "--objects " << opt.objects << " exceeds the object budget; spawning "
+            << GLApp::max_objects << " (see --max-objects)" << std::endl;
+    }
+    GLApp::objects.spawn(std::min(opt.objects, GLApp::max_objects));
+    if (GLApp::objects.empty()) {
+        std::cerr << "No objects to render" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    // Part 2
+    using clock = std::chrono::steady_clock;
+    std::vector<double> frame_ms;
+    frame_ms.reserve(opt.frames);
+
+    clock::time_point const start = clock::now();
+    for (unsigned f = 0; f < opt.frames; f++) {
+        clock::time_point const frame_start = clock::now();
+        update();
+        draw();
+        frame_ms.push_back(std::chrono::duration<double, std::milli>(clock::now() - frame_start).count());
+    }
+    glFinish();
+    double const total_s = std::chrono::duration<double>(clock::now() - start).count();
+
+    // Part 3
+    double mean_ms = 0.0, min_ms = 0.0, max_ms = 0.0;
+    if (!frame_ms.empty()) {
+        for (double ms : frame_ms) {
+            mean_ms += ms;
+        }
+        mean_ms /= static_cast<double>(frame_ms.size());
+        min_ms = *std::min_element(frame_ms.begin(), frame_ms.end());
+        max_ms = *std::max_element(frame_ms.begin(), frame_ms.end());
+    }
+    std::cout << std::fixed << std::setprecision(3)
+        << "\nHeadless run\n"
+        << "  renderer:    " << glGetString(GL_RENDERER) << '\n'
+        << "  threads:     " << GLJobs::thread_count() << '\n'
+        << "  objects:     " << GLApp::objects.size() << '\n'
+        << "  seed:        " << GLRandom::seed << '\n'
+        << "  frames:      " << frame_ms.size() << '\n'
+        << "  total:       " << total_s << " s\n"
+        << "  frame mean:  " << mean_ms << " ms\n"
+        << "  frame min:   " << min_ms << " ms\n"
+        << "  frame max:   " << max_ms << " ms\n"
+        << "  average FPS: " << (total_s > 0.0 ? frame_ms.size() / total_s : 0.0) << '\n'
+        << "  stalls:      " << GLApp::instance_stream.stall_cnt << '\n'
+        << "  simulation:  " << (GLGpuSim::enabled ? "GPU" : "CPU") << '\n'
+        << "  visible:     " << GLApp::visible_cnt << ", "
+        << GLApp::culled_cnt << " culled (last frame)\n"
+        << "  state calls: " << GLState::issued_last << " issued, "
+        << GLState::elided_last << " elided (last frame)\n\n";
+    GLProfiler::report(std::cout);
+
+    // Part 4
+    cleanup();
+    return EXIT_SUCCESS;
+}
+
 /*  _________________________________________________________________________ */
 /*! update
 @param none
@@ -65,8 +347,10 @@ For now, there are no objects to animate nor keyboard, mouse button click,
 mouse movement, and mouse scroller events to be processed.
 */
 static void update() {
-    // Part 1
-    glfwPollEvents();
+    // Part 1: there is no input to poll when headless
+    if (!GLHelper::headless) {
+        glfwPollEvents();
+    }
 
     // Part 2
     GLHelper::update_time(1.0);
@@ -88,22 +372,28 @@ static void draw() {
     GLApp::draw();
 
     // Part 2: swap buffers: front <-> back
-    glfwSwapBuffers(GLHelper::ptr_window);
+    // the offscreen framebuffer has a single color buffer, so there's
+    // nothing to swap when headless
+    if (!GLHelper::headless) {
+        glfwSwapBuffers(GLHelper::ptr_window);
+    }
 }
 
 /*  _________________________________________________________________________ */
 /*! init
-@param none
+@param bool headless
+Render offscreen instead of into a visible window
+
 @return none
 
 The OpenGL context initialization stuff is abstracted away in GLHelper::init.
 The specific initialization of OpenGL state and geometry data is
 abstracted away in GLApp::init
 */
-static void init() {
+static void init(bool headless) {
     // Part 1
     //1366x768 dimension
-    if (!GLHelper::init(1366, 768, "Tutorial 1")) {
+    if (!GLHelper::init(1366, 768, "Tutorial 1", headless)) {
         std::cout << "Unable to create OpenGL context" << std::endl;
         std::exit(EXIT_FAILURE);
     }
@@ -111,7 +401,10 @@ static void init() {
     // Part 2
     GLHelper::print_specs();
 
-    // Part 3
+    // Part 3: start the worker threads used by the game loop stages
+    GLJobs::init();
+
+    // Part 4
     GLApp::init();
 }
 
@@ -129,5 +422,8 @@ void cleanup() {
     GLApp::cleanup();
 
     // Part 2
+    GLJobs::cleanup();
+
+    // Part 3
     GLHelper::cleanup();
 }
@@ -80,6 +80,21 @@ namespace DPML
     bool                          model_centered_flag = true
   );
 
+  /*  _________________________________________________________________________*/
+  /*! parse_obj_mesh
+  Same as above, but with 32-bit triangle indices, so that meshes with more
+  than 65536 vertices can be loaded.
+  */
+  bool parse_obj_mesh(std::string filename,
+    std::vector<glm::vec3>& positions,
+    std::vector<glm::vec3>& normals,
+    std::vector<glm::vec2>& texcoords,
+    std::vector<unsigned int>& triangles,
+    bool                          load_nml_coord_flag,
+    bool                          load_tex_coord_flag,
+    bool                          model_centered_flag = true
+  );
+
 } // end namespace DPML
 
 #endif
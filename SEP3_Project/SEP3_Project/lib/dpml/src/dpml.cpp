@@ -0,0 +1,289 @@
+/* !
+@file    dpml.cpp
+@author  tan.a@digipen.edu
+@date    17/10/2026
+
+This file implements the OBJ mesh parser declared in dpml.h.
+
+Supported statements are "v", "vt", "vn" and "f"; everything else (groups,
+materials, smoothing groups, comments) is ignored. Faces may use any of the
+forms v, v/t, v//n and v/t/n, with positive or negative (relative) indices,
+and polygons are triangulated as fans. Every distinct combination of
+position/texcoord/normal indices used by a face becomes one output vertex,
+so the output arrays all have the same size. The triangle indices are
+either 16 or 32 bits wide, depending on the overload called.
+*//*__________________________________________________________________________*/
+
+#include "dpml.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+  // position, texcoord and normal index of a face corner; -1 if absent
+  using Corner = std::tuple<long, long, long>;
+
+  /*  _________________________________________________________________________*/
+  /*! resolve_index
+  Converts a 1-based (or negative, relative to the end) OBJ index into a
+  0-based index into an array of count elements. Returns -1 if the index is
+  missing or out of range.
+  */
+  long resolve_index(char const* str, size_t count)
+  {
+    if (!str || !*str)
+    {
+      return -1;
+    }
+    long const idx = std::strtol(str, nullptr, 10);
+    long const resolved = (idx < 0) ? static_cast<long>(count) + idx : idx - 1;
+    return (resolved >= 0 && resolved < static_cast<long>(count)) ? resolved : -1;
+  }
+
+  /*  _________________________________________________________________________*/
+  /*! parse_corner
+  Parses one "v", "v/t", "v//n" or "v/t/n" token of a face.
+  */
+  bool parse_corner(std::string const& token, size_t pos_cnt, size_t tex_cnt,
+                    size_t nml_cnt, Corner& corner)
+  {
+    std::string parts[3];
+    size_t part = 0;
+    for (char c : token)
+    {
+      if (c == '/')
+      {
+        if (++part > 2)
+        {
+          return false;
+        }
+      }
+      else
+      {
+        parts[part] += c;
+      }
+    }
+
+    long const p = resolve_index(parts[0].c_str(), pos_cnt);
+    long const t = parts[1].empty() ? -1 : resolve_index(parts[1].c_str(), tex_cnt);
+    long const n = parts[2].empty() ? -1 : resolve_index(parts[2].c_str(), nml_cnt);
+    if (p < 0 || (!parts[1].empty() && t < 0) || (!parts[2].empty() && n < 0))
+    {
+      return false;
+    }
+    corner = Corner(p, t, n);
+    return true;
+  }
+
+  /*  _________________________________________________________________________*/
+  /*! parse
+  Implements both overloads of parse_obj_mesh; Index is the type of the
+  triangle indices, which limits the number of output vertices.
+  */
+  template <typename Index>
+  bool parse(std::string const& filename,
+    std::vector<glm::vec3>& positions,
+    std::vector<glm::vec3>& normals,
+    std::vector<glm::vec2>& texcoords,
+    std::vector<Index>& triangles,
+    bool                          load_nml_coord_flag,
+    bool                          load_tex_coord_flag,
+    bool                          model_centered_flag)
+  {
+    std::ifstream ifs(filename);
+    if (!ifs)
+    {
+      std::cerr << "DPML: unable to open " << filename << std::endl;
+      return false;
+    }
+
+    // Part 1: read the attribute arrays and the face corners
+    std::vector<glm::vec3> file_pos, file_nml;
+    std::vector<glm::vec2> file_tex;
+    std::vector<Corner> corners;          // three per triangle
+    std::vector<Corner> face;
+
+    std::string line, keyword, token;
+    while (std::getline(ifs, line))
+    {
+      std::istringstream iss(line);
+      if (!(iss >> keyword))
+      {
+        continue;
+      }
+
+      if (keyword == "v")
+      {
+        glm::vec3 v{};
+        iss >> v.x >> v.y >> v.z;
+        file_pos.push_back(v);
+      }
+      else if (keyword == "vt")
+      {
+        glm::vec2 t{};
+        iss >> t.x >> t.y;
+        file_tex.push_back(t);
+      }
+      else if (keyword == "vn")
+      {
+        glm::vec3 n{};
+        iss >> n.x >> n.y >> n.z;
+        file_nml.push_back(n);
+      }
+      else if (keyword == "f")
+      {
+        face.clear();
+        while (iss >> token)
+        {
+          Corner c;
+          if (!parse_corner(token, file_pos.size(), file_tex.size(), file_nml.size(), c))
+          {
+            std::cerr << "DPML: bad face \"" << line << "\" in " << filename << std::endl;
+            return false;
+          }
+          face.push_back(c);
+        }
+        for (size_t i = 2; i < face.size(); i++)
+        {
+          corners.push_back(face[0]);
+          corners.push_back(face[i - 1]);
+          corners.push_back(face[i]);
+        }
+      }
+    }
+
+    // Part 2: one output vertex per distinct corner; attributes that are not
+    // loaded don't distinguish corners
+    bool const use_tex = load_tex_coord_flag && !file_tex.empty();
+    bool const use_file_nml = load_nml_coord_flag && !file_nml.empty();
+
+    std::map<Corner, Index> vertex_of;
+    triangles.reserve(corners.size());
+    for (Corner c : corners)
+    {
+      if (!use_tex)
+      {
+        std::get<1>(c) = -1;
+      }
+      if (!use_file_nml)
+      {
+        std::get<2>(c) = -1;
+      }
+
+      auto const it = vertex_of.find(c);
+      if (it != vertex_of.end())
+      {
+        triangles.push_back(it->second);
+        continue;
+      }
+
+      if (positions.size() > static_cast<size_t>(std::numeric_limits<Index>::max()))
+      {
+        std::cerr << "DPML: " << filename << " has too many vertices for "
+          << sizeof(Index) * 8 << "-bit indices" << std::endl;
+        return false;
+      }
+      Index const idx = static_cast<Index>(positions.size());
+      vertex_of.emplace(c, idx);
+      triangles.push_back(idx);
+
+      positions.push_back(file_pos[std::get<0>(c)]);
+      if (load_tex_coord_flag)
+      {
+        texcoords.push_back(std::get<1>(c) >= 0 ? file_tex[std::get<1>(c)] : glm::vec2(0.0f));
+      }
+      if (use_file_nml)
+      {
+        normals.push_back(std::get<2>(c) >= 0 ? file_nml[std::get<2>(c)] : glm::vec3(0.0f));
+      }
+    }
+
+    if (positions.empty())
+    {
+      std::cerr << "DPML: " << filename << " has no faces" << std::endl;
+      return false;
+    }
+
+    // Part 3: compute area-weighted vertex normals if the file has none
+    if (load_nml_coord_flag && !use_file_nml)
+    {
+      normals.assign(positions.size(), glm::vec3(0.0f));
+      for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+      {
+        glm::vec3 const& p0 = positions[triangles[i]];
+        glm::vec3 const& p1 = positions[triangles[i + 1]];
+        glm::vec3 const& p2 = positions[triangles[i + 2]];
+        glm::vec3 const n = glm::cross(p1 - p0, p2 - p0);
+        normals[triangles[i]] += n;
+        normals[triangles[i + 1]] += n;
+        normals[triangles[i + 2]] += n;
+      }
+    }
+    for (glm::vec3& n : normals)
+    {
+      float const len = glm::length(n);
+      n = (len > 0.0f) ? n / len : glm::vec3(0.0f, 0.0f, 1.0f);
+    }
+
+    // Part 4: centre the axis-aligned bounding box at the origin
+    if (model_centered_flag)
+    {
+      glm::vec3 lo = positions[0], hi = positions[0];
+      for (glm::vec3 const& p : positions)
+      {
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+      }
+      glm::vec3 const centre = (lo + hi) * 0.5f;
+      for (glm::vec3& p : positions)
+      {
+        p -= centre;
+      }
+    }
+
+    return true;
+  }
+}
+
+namespace DPML
+{
+  /*  _________________________________________________________________________*/
+  /*! parse_obj_mesh
+  See dpml.h.
+  */
+  bool parse_obj_mesh(std::string filename,
+    std::vector<glm::vec3>& positions,
+    std::vector<glm::vec3>& normals,
+    std::vector<glm::vec2>& texcoords,
+    std::vector<unsigned short>& triangles,
+    bool                          load_nml_coord_flag,
+    bool                          load_tex_coord_flag,
+    bool                          model_centered_flag)
+  {
+    return parse(filename, positions, normals, texcoords, triangles,
+      load_nml_coord_flag, load_tex_coord_flag, model_centered_flag);
+  }
+
+  /*  _________________________________________________________________________*/
+  /*! parse_obj_mesh
+  See dpml.h.
+  */
+  bool parse_obj_mesh(std::string filename,
+    std::vector<glm::vec3>& positions,
+    std::vector<glm::vec3>& normals,
+    std::vector<glm::vec2>& texcoords,
+    std::vector<unsigned int>& triangles,
+    bool                          load_nml_coord_flag,
+    bool                          load_tex_coord_flag,
+    bool                          model_centered_flag)
+  {
+    return parse(filename, positions, normals, texcoords, triangles,
+      load_nml_coord_flag, load_tex_coord_flag, model_centered_flag);
+  }
+
+} // end namespace DPML
@@ -0,0 +1,157 @@
+/* !
+@file    cull.glsl
+@author  tan.a@digipen.edu
+@date    17/10/2026
+
+This file contains the declarations shared by the compute shaders of GPU
+culling (see GLGpuCull): the buffers, the visibility test and the work
+group scan that ranks visible objects per model. It is included
+with #include "cull.glsl" after the #version directive.
+
+The binding points and sizes must match those of GLGpuCull.
+*//*__________________________________________________________________________*/
+
+
+#define GROUP_SIZE 256u
+#define MAX_MODELS 8u
+
+
+#include "object.glsl"
+
+
+/**
+
+@brief States of the objects, read by age through object_at: in spawn
+       order, or the ring of slots kept resident by GPU simulation.
+*/
+layout (std430, binding = 0) readonly buffer Objects {
+	Object objects[];
+};
+
+
+/**
+
+@brief Visible objects of each model in each work group, at
+       group * MAX_MODELS + model; replaced by the first instance of the
+       group's visible objects of the model by the scan.
+*/
+layout (std430, binding = 1) buffer GroupCounts {
+	uint group_counts[];
+};
+
+
+/**
+
+@brief One glMultiDrawElementsIndirect command per model. count and the
+       fields after it are set once; the scan writes the others.
+*/
+struct DrawCommand {
+	uint count;
+	uint instance_count;
+	uint first_index;
+	int base_vertex;
+	uint base_instance;
+};
+
+layout (std430, binding = 2) buffer Commands {
+	DrawCommand commands[];
+};
+
+
+/**
+
+@brief Model-to-NDC transforms of the visible objects, 9 floats (a
+       column-major mat3) per instance, read as the per-instance attribute
+       of the instanced vertex shader.
+*/
+layout (std430, binding = 3) writeonly buffer Instances {
+	float instances[];
+};
+
+
+// number of objects and view rectangle in world coordinates
+uniform int uCount;
+uniform vec2 uViewMin;
+uniform vec2 uViewMax;
+
+// the objects are a ring of uCapacity elements whose oldest is at uFirst
+uniform int uFirst;
+uniform int uCapacity;
+
+
+/*  _________________________________________________________________________ */
+/*! object_at
+
+@brief
+fetches an object by age
+
+@param i
+number of live objects spawned before it; less than uCount
+
+@return Object
+the object
+*/
+Object object_at(uint i) {
+	return objects[(uint(uFirst) + i) % uint(uCapacity)];
+}
+
+
+/*  _________________________________________________________________________ */
+/*! visible
+
+@brief
+tests the bounding circle of an object against the view rectangle
+
+@param o
+the object
+
+@return bool
+true if the circle overlaps the rectangle; objects of models beyond
+MAX_MODELS are never visible
+*/
+bool visible(Object o) {
+	vec2 d = o.position - clamp(o.position, uViewMin, uViewMax);
+	return o.model < MAX_MODELS && dot(d, d) <= o.radius * o.radius;
+}
+
+
+// per-model counts packed in a uvec4: model m is counted in the 16-bit half
+// (m & 1) of component m >> 1, which is enough for GROUP_SIZE objects
+shared uvec4 scan_counts[GROUP_SIZE];
+
+uvec4 one_hot(uint model) {
+	uvec4 v = uvec4(0u);
+	v[model >> 1u] = 1u << ((model & 1u) * 16u);
+	return v;
+}
+
+uint count_of(uvec4 v, uint model) {
+	return (v[model >> 1u] >> ((model & 1u) * 16u)) & 0xFFFFu;
+}
+
+
+/*  _________________________________________________________________________ */
+/*! group_scan
+
+@brief
+inclusive prefix sum of the packed per-model counts of the invocations of
+the work group, in invocation order. It must be called by every invocation.
+
+@param v
+packed counts of this invocation
+
+@return uvec4
+packed counts of this invocation and every invocation before it
+*/
+uvec4 group_scan(uvec4 v) {
+	uint i = gl_LocalInvocationID.x;
+	scan_counts[i] = v;
+	barrier();
+	for (uint step = 1u; step < GROUP_SIZE; step <<= 1u) {
+		uvec4 add = (i >= step) ? scan_counts[i - step] : uvec4(0u);
+		barrier();
+		scan_counts[i] += add;
+		barrier();
+	}
+	return scan_counts[i];
+}
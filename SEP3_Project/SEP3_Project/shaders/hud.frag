@@ -0,0 +1,38 @@
+/* !
+@file    hud.frag
+@author  tan.a@digipen.edu
+@date	 17/10/2026
+
+This file contains the fragment shader program of the stats overlay, which
+outputs the color of the glyph quads.
+*//*__________________________________________________________________________*/
+
+
+#version 450 core
+
+/**
+@brief Specifies the input vertex attribute for the color of the quad.
+*/
+layout (location=0) in vec4 vColor;
+
+
+/**
+@brief Specifies the output fragment attribute for the fragment color.
+*/
+layout (location=0) out vec4 fFragColor;
+
+
+/*  _________________________________________________________________________ */
+/*! main
+
+@brief
+the main function of the shader program
+which sets the color of the fragment
+
+@param none
+
+@return none
+*/
+void main () {
+	fFragColor = vColor;
+}
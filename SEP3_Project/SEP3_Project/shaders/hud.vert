@@ -0,0 +1,61 @@
+/* !
+@file    hud.vert
+@author  tan.a@digipen.edu
+@date	 17/10/2026
+
+This file contains the vertex shader program of the stats overlay. The
+vertices are the quads generated by stb_easy_font, in pixels with the origin
+at the top-left corner of the viewport.
+*//*__________________________________________________________________________*/
+
+#version 450 core
+
+
+/**
+
+@brief Specifies the input vertex attribute for position in the vertex shader.
+       The position is given in pixels; stb_easy_font also writes a z
+       coordinate, which is ignored.
+*/
+layout (location=0) in vec3 aVertexPosition;
+
+
+/**
+
+@brief Specifies the input vertex attribute for color in the vertex shader.
+       The color is stored as 4 normalized unsigned bytes.
+*/
+layout (location=1) in vec4 aVertexColor;
+
+
+/**
+
+@brief Maps pixels to NDC: the viewport's top-left corner maps to (-1, 1)
+       and uPixelToNDC holds the text scale times (2 / width, -2 / height).
+*/
+uniform vec2 uPixelToNDC;
+
+
+/**
+
+@brief Specifies the output vertex attribute for color in the vertex shader.
+*/
+layout (location=0) out vec4 vColor;
+
+
+
+/*  _________________________________________________________________________ */
+/*! main
+
+@brief
+the main function of the shader program
+which maps the vertex from pixels to NDC and passes its color on
+
+@param none
+
+@return none
+*/
+void main() {
+	gl_Position = vec4(aVertexPosition.xy * uPixelToNDC + vec2(-1.0, 1.0), 0.0, 1.0);
+	vColor = aVertexColor;
+}
@@ -5,6 +5,10 @@
 
 This file contains a vertex shader program that takes in per-vertex postion
 and color attribute and outputsthe position as well as the color
+
+With INSTANCED defined, the model-to-NDC transform is read from a
+per-instance vertex attribute instead of a uniform, so that all objects of
+a model are drawn with one instanced draw call (see GLApp::draw_instanced).
 *//*__________________________________________________________________________*/
 
 #version 450 core
@@ -50,8 +54,21 @@ layout (location=1) in vec3 aVertexColor;
 */
 layout (location=0) out vec3 vColor;
 
+#ifdef INSTANCED
+/**
+
+@brief Specifies the per-instance model-to-NDC transform. A mat3 attribute
+       occupies three consecutive locations (2, 3 and 4), one per column.
+       The attributes are sourced from GLApp::instance_stream with a divisor
+       of 1 so that the value advances once per instance, not per vertex.
+*/
+layout (location=2) in mat3 uModel_to_NDC;
+#else
 //declare a uniform mat3
 uniform mat3 uModel_to_NDC;
+#endif
+
+#include "transform.glsl"
 
 
 
@@ -72,7 +89,7 @@ and the input attributes
 void main(void){
 
 	//set the position
-	gl_Position = vec4(vec2(uModel_to_NDC * vec3(aVertexPosition, 1.f)), 0.0, 1.0);
+	gl_Position = model_to_ndc(uModel_to_NDC, aVertexPosition);
 	//set the color
 	vColor = aVertexColor;
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+/* !
+@file    object.glsl
+@author  tan.a@digipen.edu
+@date    17/10/2026
+
+This file contains the state of an object as kept in shader storage buffers
+by GPU culling and GPU simulation (see GLGpuCull::Object). It is included
+with #include "object.glsl" by the compute shaders that declare such a
+buffer, with the numbering of their work groups.
+*//*__________________________________________________________________________*/
+
+
+/**
+
+@brief State of one object. radius is the radius of its bounding circle in
+       world coordinates; angle and angle_speed are in degrees and degrees
+       per second.
+*/
+struct Object {
+	vec2 position;
+	vec2 scaling;
+	float angle;
+	uint model;
+	float radius;
+	float angle_speed;
+};
+
+
+/*  _________________________________________________________________________ */
+/*! group_index
+
+@brief
+number of the work group, the groups being dispatched in rows of
+gl_NumWorkGroups.x (see GLGpuCull::dispatch_groups)
+
+@param none
+
+@return uint
+index of the work group; the last row may have groups past the last one
+*/
+uint group_index() {
+	return gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+}
@@ -0,0 +1,44 @@
+/* !
+@file    transform.glsl
+@author  tan.a@digipen.edu
+@date    17/10/2026
+
+This file contains the model-to-NDC transform shared by the vertex shaders.
+It is included with #include "transform.glsl" after the #version directive
+(see GLSLShader::ReadShaderFile) and follows the QUANTIZED_POS permutation.
+*//*__________________________________________________________________________*/
+
+
+#ifdef QUANTIZED_POS
+/**
+
+@brief Specifies how the model's positions are decoded (see GLVertexFormat).
+       Quantized positions arrive normalized to [-1, 1] over the model's
+       bounding box; xy scales them back and zw offsets them.
+*/
+uniform vec4 uPosDecode;
+#endif
+
+
+/*  _________________________________________________________________________ */
+/*! model_to_ndc
+
+@brief
+transforms a vertex position, decoded first if positions are quantized,
+from model coordinates to NDC
+
+@param xform
+the model-to-NDC transform of the object
+
+@param position
+the vertex position as read from the vertex buffer
+
+@return vec4
+the clip-space position
+*/
+vec4 model_to_ndc(mat3 xform, vec2 position){
+#ifdef QUANTIZED_POS
+	position = position * uPosDecode.xy + uPosDecode.zw;
+#endif
+	return vec4(vec2(xform * vec3(position, 1.f)), 0.0, 1.0);
+}